@@ -0,0 +1,395 @@
+#include "DynamicHull.hpp"
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+// Shoelace term of the edge a -> b (unchanged by mirroring both points)
+static double term(const Point& a, const Point& b) {
+    return static_cast<double>(a.x) * b.y - static_cast<double>(b.x) * a.y;
+}
+
+static Point mirror(const Point& p) {
+    return {-p.x, -p.y};
+}
+
+// A point in the coordinates of side s
+static Point view(const Point& p, int s) {
+    return s ? mirror(p) : p;
+}
+
+static bool isLeaf(const HullNode* u) {
+    return !u->child[0];
+}
+
+// ========== Chains ==========
+// A node's chain on one side is never stored: these walk it through the bridges.
+// Comparisons are in (x, y) order, which acts as x on a slightly sheared plane,
+// so vertical edges and duplicate x need no special cases.
+
+// A stretch [lo, hi] of a node's chain, narrowed as a bridge search descends
+struct ChainCursor {
+    const HullNode* node;
+    int side;
+    const Point* lo = nullptr;                // Unbounded while null
+    const Point* hi = nullptr;
+
+    ChainCursor(const HullNode* node, int side) : node(node), side(side) {}
+
+    // The bridge of the node covering the stretch, or nullptr once it is one vertex
+    const Point* edge() {
+        while (!isLeaf(node)) {
+            const Point* b = node->bridge[side];
+            if (hi && !(b[0] < *hi)) node = node->child[side];
+            else if (lo && !(*lo < b[1])) node = node->child[1 - side];
+            else return b;
+        }
+        return nullptr;
+    }
+    Point vertex() const { return view(node->key, side); }
+    void left(const Point* b) { hi = &b[0]; node = node->child[side]; }
+    void right(const Point* b) { lo = &b[1]; node = node->child[1 - side]; }
+};
+
+// Shoelace sum of the chain up to vertex x, or from x on when !before
+static double partialSum(const HullNode* u, int s, const Point& x, bool before) {
+    double total = 0.0, sign = 1.0;
+    while (!isLeaf(u)) {
+        bool inFirst = !(u->bridge[s][0] < x);
+        if (inFirst != before) {              // The part wanted spans the bridge: whole chain minus the rest
+            total += sign * u->sum[s];
+            sign = -sign;
+            before = !before;
+        }
+        u = u->child[inFirst ? s : 1 - s];
+    }
+    return total;
+}
+
+// Where the lines through edges a and b, a the shallower, meet relative to m in
+// (x, y) order: > 0 after m, 0 at m, < 0 before
+static double meetSide(const Point* a, const Point* b, const Point& m) {
+    double ax = static_cast<double>(a[1].x) - a[0].x, ay = static_cast<double>(a[1].y) - a[0].y;
+    double bx = static_cast<double>(b[1].x) - b[0].x, by = static_cast<double>(b[1].y) - b[0].y;
+    double ca = cross(a[0], a[1], m), cb = cross(b[0], b[1], m);
+    double side = cb * ax - ca * bx;          // Sign of (line a - line b) at x = m.x
+    if (side == 0) side = cb * ay - ca * by;  // They meet at m.x: the shear orders by y
+    return side;
+}
+
+// Bridge of u's chain on side s, between its first child's chain a and its
+// second child's chain b. Both are searched at once: each step rules out one
+// side of one candidate edge, so it ends after O(height) steps. On a collinear
+// bridge the outermost points are kept, as convexHull() does.
+//
+// When a is the shallower edge, the bridge lies left of b's edge if the two
+// lines meet after the last point of a, and right of a's edge if they meet
+// before the first point of b; both cannot fail. Either test holds against
+// any point in between, and u's key is one, at or after a's last point.
+static void findBridge(const HullNode* u, int s, Point bridge[2]) {
+    ChainCursor a(u->child[s], s), b(u->child[1 - s], s);
+    Point m = view(u->key, s);
+    while (true) {
+        const Point* ea = a.edge();
+        const Point* eb = b.edge();
+        if (!ea && !eb) break;
+        if (!ea) {                            // Tangent from a's vertex to b
+            if (cross(a.vertex(), eb[0], eb[1]) <= 0) b.right(eb);
+            else b.left(eb);
+        } else if (!eb) {                     // Tangent from b's vertex to a
+            if (cross(ea[0], b.vertex(), ea[1]) < 0) a.right(ea);
+            else a.left(ea);
+        } else {
+            double turn = (static_cast<double>(ea[1].x) - ea[0].x) * (static_cast<double>(eb[1].y) - eb[0].y) -
+                          (static_cast<double>(ea[1].y) - ea[0].y) * (static_cast<double>(eb[1].x) - eb[0].x);
+            if (turn <= 0) {                  // a at least as steep as b
+                if (cross(ea[0], ea[1], eb[0]) < 0) a.left(ea);
+                else b.right(eb);
+            } else if (s ? meetSide(ea, eb, m) >= 0 : meetSide(ea, eb, m) > 0) {
+                b.left(eb);
+            } else {
+                a.right(ea);
+            }
+        }
+    }
+    bridge[0] = a.vertex();
+    bridge[1] = b.vertex();
+}
+
+// ========== Tree ==========
+
+// Recomputes u's bridge and chain sum on side s from its children
+static void join(HullNode* u, int s) {
+    Point* b = u->bridge[s];
+    findBridge(u, s, b);
+    u->sum[s] = partialSum(u->child[s], s, b[0], true) + term(b[0], b[1]) +
+                partialSum(u->child[1 - s], s, b[1], false);
+}
+
+static void update(HullNode* u) {
+    u->height = 1 + std::max(u->child[0]->height, u->child[1]->height);
+}
+
+// After the children of u changed: rebuilds everything u stores
+static void pull(HullNode* u) {
+    update(u);
+    join(u, 0);
+    join(u, 1);
+}
+
+// Whether p, one of u's points, is a vertex of u's chain on side s
+static bool isVertex(const HullNode* u, int s, const Point& p) {
+    Point v = view(p, s);
+    while (!isLeaf(u)) {
+        const Point* b = u->bridge[s];
+        if (!(b[0] < v)) u = u->child[s];
+        else if (!(v < b[1])) u = u->child[1 - s];
+        else return false;
+    }
+    return true;
+}
+
+// Whether p, a vertex of child c's chain, is on the part of u's chain taken from c
+static bool visible(const HullNode* u, int s, const Point& p, int c) {
+    Point v = view(p, s);
+    const Point* b = u->bridge[s];
+    return c == s ? !(b[0] < v) : !(v < b[1]);
+}
+
+// Whether p lies over u's bridge on side s, so that adding p leaves u's chain as it was
+static bool covered(const HullNode* u, int s, const Point& p) {
+    Point v = view(p, s);
+    const Point* b = u->bridge[s];
+    return b[0] < v && v < b[1] && cross(b[0], b[1], v) >= 0;
+}
+
+// Lifts u's child c into u's place; the caller pulls both
+static HullNode* rotate(HullNode* u, int c) {
+    HullNode* top = u->child[c];
+    u->child[c] = top->child[1 - c];
+    top->child[1 - c] = u;
+    return top;
+}
+
+static bool balanced(const HullNode* u) {
+    return std::abs(u->child[0]->height - u->child[1]->height) <= 1;
+}
+
+// Single or double rotation; each node that moved is pulled once, children first
+static HullNode* rebalance(HullNode* u) {
+    int c = u->child[0]->height > u->child[1]->height ? 0 : 1;
+    HullNode* tall = u->child[c];
+    bool zigzag = tall->child[1 - c]->height > tall->child[c]->height;
+    if (zigzag) u->child[c] = rotate(tall, 1 - c);
+    HullNode* top = rotate(u, c);
+    if (zigzag) pull(tall);
+    pull(u);
+    pull(top);
+    return top;
+}
+
+static HullNode* makeLeaf(const Point& p, size_t count) {
+    HullNode* leaf = new HullNode;
+    leaf->key = p;
+    leaf->count = count;
+    return leaf;
+}
+
+// Adds p below u; onHull[s] tells whether p is now a vertex of the subtree's chain on side s
+static HullNode* insertAt(HullNode* u, const Point& p, bool onHull[2]) {
+    if (isLeaf(u)) {
+        if (u->key == p) {
+            ++u->count;
+            onHull[0] = onHull[1] = false;
+            return u;
+        }
+        HullNode* parent = new HullNode;
+        bool before = p < u->key;
+        parent->key = before ? p : u->key;
+        parent->child[before ? 1 : 0] = u;
+        parent->child[before ? 0 : 1] = makeLeaf(p, 1);
+        pull(parent);
+        onHull[0] = onHull[1] = true;
+        return parent;
+    }
+
+    int c = u->key < p ? 1 : 0;
+    int height = u->child[c]->height;
+    u->child[c] = insertAt(u->child[c], p, onHull);
+    if (u->child[c]->height != height) {      // Else u's height and balance stand
+        update(u);
+        if (!balanced(u)) {
+            u = rebalance(u);
+            for (int s = 0; s < 2; ++s) onHull[s] = onHull[s] && isVertex(u, s, p);
+            return u;
+        }
+    }
+    for (int s = 0; s < 2; ++s) {
+        if (!onHull[s]) continue;             // The chain below is unchanged, and so is u's
+        if (covered(u, s, p)) {
+            onHull[s] = false;
+            continue;
+        }
+        join(u, s);
+        onHull[s] = visible(u, s, p, c);
+    }
+    return u;
+}
+
+// Removes one copy of p below u; onHull[s] tells whether p was a vertex of the
+// subtree's chain on side s before the last copy went
+static HullNode* eraseAt(HullNode* u, const Point& p, bool onHull[2], bool& found) {
+    if (isLeaf(u)) {
+        found = u->key == p;
+        onHull[0] = onHull[1] = found && u->count == 1;
+        if (!found || --u->count > 0) return u;
+        delete u;
+        return nullptr;
+    }
+
+    int c = u->key < p ? 1 : 0;
+    int height = u->child[c]->height;
+    HullNode* rest = eraseAt(u->child[c], p, onHull, found);
+    for (int s = 0; s < 2; ++s) onHull[s] = onHull[s] && visible(u, s, p, c);
+    if (!rest) {
+        HullNode* sibling = u->child[1 - c];
+        delete u;
+        return sibling;
+    }
+    u->child[c] = rest;
+    if (rest->height != height) {
+        update(u);
+        if (!balanced(u)) return rebalance(u);
+    }
+    for (int s = 0; s < 2; ++s) {
+        if (onHull[s]) join(u, s);
+    }
+    return u;
+}
+
+// Balanced tree over sorted distinct points, joined bottom-up in O(n) overall
+static HullNode* build(const std::vector<std::pair<Point, size_t>>& leaves, size_t begin, size_t end) {
+    if (end - begin == 1) return makeLeaf(leaves[begin].first, leaves[begin].second);
+    size_t mid = begin + (end - begin) / 2;
+    HullNode* u = new HullNode;
+    u->key = leaves[mid - 1].first;
+    u->child[0] = build(leaves, begin, mid);
+    u->child[1] = build(leaves, mid, end);
+    pull(u);
+    return u;
+}
+
+static void collectLeaves(const HullNode* u, std::vector<std::pair<Point, size_t>>& out) {
+    if (isLeaf(u)) {
+        out.emplace_back(u->key, u->count);
+        return;
+    }
+    collectLeaves(u->child[0], out);
+    collectLeaves(u->child[1], out);
+}
+
+// Appends the vertices of u's chain on side s within [lo, hi], in side coordinates
+static void collectChain(const HullNode* u, int s, const Point* lo, const Point* hi, std::vector<Point>& out) {
+    while (!isLeaf(u)) {
+        const Point* b = u->bridge[s];
+        if (hi && !(b[0] < *hi)) {
+            u = u->child[s];
+        } else if (lo && !(*lo < b[1])) {
+            u = u->child[1 - s];
+        } else {
+            collectChain(u->child[s], s, lo, &b[0], out);
+            lo = &b[1];
+            u = u->child[1 - s];
+        }
+    }
+    out.push_back(view(u->key, s));
+}
+
+static void destroy(HullNode* u) {
+    if (!u) return;
+    if (!isLeaf(u)) {
+        destroy(u->child[0]);
+        destroy(u->child[1]);
+    }
+    delete u;
+}
+
+// ========== DynamicHull ==========
+
+DynamicHull::~DynamicHull() {
+    destroy(root);
+}
+
+void DynamicHull::clear() {
+    destroy(root);
+    root = nullptr;
+    total = 0;
+}
+
+void DynamicHull::insert(const Point& p) {
+    ++total;
+    if (!root) {
+        root = makeLeaf(p, 1);
+        return;
+    }
+    bool onHull[2];
+    root = insertAt(root, p, onHull);
+}
+
+// One by one, k points cost O(k log^2 n); rebuilding costs O(n) after
+// sorting the batch, which wins once k approaches n / log n
+void DynamicHull::insert(const std::vector<Point>& batch) {
+    size_t depth = 1;
+    while ((size_t(1) << depth) < total + batch.size()) ++depth;
+    if (batch.size() * depth < total) {
+        for (const Point& p : batch) insert(p);
+        return;
+    }
+    if (batch.empty()) return;
+
+    std::vector<Point> sorted = batch;
+    std::sort(sorted.begin(), sorted.end());
+    std::vector<std::pair<Point, size_t>> old, merged;
+    if (root) collectLeaves(root, old);
+    merged.reserve(old.size() + sorted.size());
+    size_t i = 0;
+    for (const Point& p : sorted) {
+        while (i < old.size() && old[i].first < p) merged.push_back(old[i++]);
+        if (i < old.size() && old[i].first == p) merged.push_back(old[i++]);
+        if (!merged.empty() && merged.back().first == p) ++merged.back().second;
+        else merged.emplace_back(p, 1);
+    }
+    merged.insert(merged.end(), old.begin() + i, old.end());
+
+    destroy(root);
+    root = build(merged, 0, merged.size());
+    total += batch.size();
+}
+
+bool DynamicHull::erase(const Point& p) {
+    if (!root) return false;
+    bool onHull[2], found = false;
+    root = eraseAt(root, p, onHull, found);
+    if (found) --total;
+    return found;
+}
+
+size_t DynamicHull::count(const Point& p) const {
+    if (!root) return 0;
+    const HullNode* u = root;
+    while (!isLeaf(u)) u = u->child[u->key < p ? 1 : 0];
+    return u->key == p ? u->count : 0;
+}
+
+float DynamicHull::area() const {
+    if (!root) return 0.0f;
+    return static_cast<float>(std::abs(root->sum[0] + root->sum[1]) / 2.0);
+}
+
+std::vector<Point> DynamicHull::hull() const {
+    std::vector<Point> H, upper;
+    if (!root) return H;
+    collectChain(root, 0, nullptr, nullptr, H);
+    collectChain(root, 1, nullptr, nullptr, upper);
+    for (size_t i = 1; i + 1 < upper.size(); ++i) H.push_back(mirror(upper[i]));
+    return H;
+}
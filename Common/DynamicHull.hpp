@@ -0,0 +1,46 @@
+#pragma once
+#include "Geometry.hpp"
+#include <vector>
+#include <cstddef>
+
+// Node of a DynamicHull. Leaves hold the distinct points in (x, y) order.
+// On either side, an internal node's chain is its first child's chain up to
+// bridge[side][0] followed by its second child's chain from bridge[side][1].
+// Side 1, the upper hull, is the lower hull of the mirrored points (-x, -y):
+// their order is reversed, so its first child is child[1].
+struct HullNode {
+    HullNode* child[2] = {nullptr, nullptr};  // Both null for a leaf
+    Point key;                                // A leaf's point; else child[0] <= key < child[1]
+    int height = 0;                           // 0 for a leaf
+    size_t count = 0;                         // Copies of a leaf's point
+    Point bridge[2][2];                       // Per side, in that side's coordinates
+    double sum[2] = {0.0, 0.0};               // Shoelace sum along each side's chain
+};
+
+// Convex hull maintained under point insertions and deletions, after
+// Overmars and van Leeuwen: an AVL tree over the points whose internal nodes
+// keep only the bridges between their children's chains. Finding a bridge
+// descends both children at once, O(log n). An update rejoins the nodes above
+// the point, on each side only while the point is still a vertex there.
+// The leaves count duplicates, so the tree is also the graph's point set.
+class DynamicHull {
+public:
+    DynamicHull() = default;
+    ~DynamicHull();
+
+    DynamicHull(const DynamicHull&) = delete;
+    DynamicHull& operator=(const DynamicHull&) = delete;
+
+    void clear();
+    void insert(const Point& p);              // O(log^2 n)
+    void insert(const std::vector<Point>& batch);  // Rebuilds in O(n + k log k) when k is large
+    bool erase(const Point& p);               // Removes one copy in O(log^2 n); false if p is absent
+    size_t count(const Point& p) const;       // Copies of p, O(log n)
+    float area() const;                       // O(1)
+    std::vector<Point> hull() const;          // O(h log n), same order as convexHull()
+    size_t size() const { return total; }
+
+private:
+    HullNode* root = nullptr;
+    size_t total = 0;                         // Points, duplicates included
+};
@@ -0,0 +1,52 @@
+#include "Geometry.hpp"
+#include "ParallelHull.hpp"
+#include "Prefilter.hpp"
+#include "Simd.hpp"
+#include "RadixSort.hpp"
+#include "HullAlgorithms.hpp"
+#include <utility>
+#include <cmath>
+
+// Hull of (already prefiltered) points with the engine suited to their size and shape
+static std::vector<Point> hullOfFiltered(std::vector<Point> P) {
+    if (P.size() >= kParallelHullThreshold && hullThreads() > 1) {
+        return parallelConvexHull(std::move(P));
+    }
+    return runHullAlgorithm(selectHullAlgorithm(P), std::move(P));
+}
+
+std::vector<Point> convexHull(std::vector<Point> P) {
+    if (P.size() >= kPrefilterThreshold) aklToussaintFilter(P);
+    return hullOfFiltered(std::move(P));
+}
+
+std::vector<Point> convexHull(const PointArray& P) {
+    if (P.size() < kPrefilterThreshold) return hullOfFiltered(P.snapshot());
+    return hullOfFiltered(aklToussaintFilter(P));
+}
+
+std::vector<Point> hullOfSorted(const Point* P, int n) {
+    int k = 0;
+    if (n <= 1) return std::vector<Point>(P, P + n);
+
+    std::vector<Point> H(2 * n);
+
+    // Lower hull
+    for (int i = 0; i < n; ++i) {
+        while (k >= 2 && cross(H[k - 2], H[k - 1], P[i]) <= 0) k--;
+        H[k++] = P[i];
+    }
+
+    // Upper hull
+    for (int i = n - 2, t = k + 1; i >= 0; --i) {
+        while (k >= t && cross(H[k - 2], H[k - 1], P[i]) <= 0) k--;
+        H[k++] = P[i];
+    }
+
+    H.resize(k - 1);
+    return H;
+}
+
+float polygonArea(const std::vector<Point>& poly) {
+    return static_cast<float>(std::abs(shoelaceSum(poly.data(), poly.size())) / 2.0);
+}
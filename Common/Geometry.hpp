@@ -0,0 +1,45 @@
+#pragma once
+#include <cmath>
+#include <vector>
+
+// ======== Point ========
+struct Point {
+    float x, y;
+
+    bool operator==(const Point& other) const {
+        return x == other.x && y == other.y;
+    }
+
+    bool operator<(const Point& p) const {
+        return (x < p.x || (x == p.x && y < p.y));
+    }
+};
+
+// NaN and infinities break the ordering and equality that storage and hulls rely on
+inline bool isFinite(const Point& p) {
+    return std::isfinite(p.x) && std::isfinite(p.y);
+}
+
+inline bool allFinite(const std::vector<Point>& P) {
+    for (const Point& p : P) {
+        if (!isFinite(p)) return false;
+    }
+    return true;
+}
+
+// ======== Geometry ========
+
+class PointArray;
+
+// Cross product of OA and OB (> 0 when O -> A -> B turns left), in double:
+// the products of float differences are exact, so the sign is only lost to
+// the final rounding and every hull algorithm agrees on every turn
+inline double cross(const Point& O, const Point& A, const Point& B) {
+    return (static_cast<double>(A.x) - O.x) * (static_cast<double>(B.y) - O.y) -
+           (static_cast<double>(A.y) - O.y) * (static_cast<double>(B.x) - O.x);
+}
+
+std::vector<Point> convexHull(std::vector<Point> P);   // Counter-clockwise, algorithm picked by input
+std::vector<Point> convexHull(const PointArray& P);    // Same, prefiltering straight from SoA storage
+std::vector<Point> hullOfSorted(const Point* P, int n); // Monotone chain over points sorted by (x, y)
+float polygonArea(const std::vector<Point>& poly);     // Shoelace formula
@@ -0,0 +1,63 @@
+#include "GraphRegistry.hpp"
+#include <functional>
+
+// ========== Graph ==========
+
+Graph::Graph(EpochDomain& epochs) : retired(epochs), snapshot(new GraphSnapshot) {}
+
+Graph::~Graph() {
+    delete snapshot.load();
+}
+
+// Copies the hull under the lock, indexes it outside, then swaps it in only
+// if no newer snapshot was published meanwhile and retires the one replaced
+void Graph::publish() {
+    std::unique_ptr<GraphSnapshot> snap;
+    std::vector<Point> vertices;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (snapshot.load(std::memory_order_relaxed)->version == version) return;
+        snap.reset(new GraphSnapshot);
+        snap->version = version;
+        snap->area = hull.area();
+        vertices = hull.hull();
+    }
+    snap->queries.build(vertices);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    const GraphSnapshot* old = snapshot.load(std::memory_order_relaxed);
+    if (old->version >= snap->version) return;
+    snapshot.store(snap.release(), std::memory_order_release);
+    retired.retire(old);
+}
+
+// ========== GraphRegistry ==========
+
+GraphRegistry::GraphRegistry(size_t shardCount, size_t maxGraphs)
+    : shardCount(shardCount == 0 ? 1 : shardCount), maxGraphs(maxGraphs),
+      shards(new Shard[this->shardCount]) {}
+
+Graph* GraphRegistry::get(const std::string& name) {
+    Shard& shard = shards[std::hash<std::string>()(name) % shardCount];
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto it = shard.graphs.find(name);
+    if (it != shard.graphs.end()) return it->second.get();
+
+    // Graphs are never freed, so their number is what bounds the memory
+    if (graphCount.fetch_add(1) >= maxGraphs) {
+        graphCount.fetch_sub(1);
+        return nullptr;
+    }
+    Graph* graph = new Graph(epochDomain);
+    shard.graphs.emplace(name, std::unique_ptr<Graph>(graph));
+    return graph;
+}
+
+size_t GraphRegistry::size() const {
+    size_t total = 0;
+    for (size_t i = 0; i < shardCount; ++i) {
+        std::lock_guard<std::mutex> lock(shards[i].mutex);
+        total += shards[i].graphs.size();
+    }
+    return total;
+}
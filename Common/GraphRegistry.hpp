@@ -0,0 +1,70 @@
+#pragma once
+#include "DynamicHull.hpp"
+#include "HullQueries.hpp"
+#include "Rcu.hpp"
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+// ======== Snapshots ========
+// Immutable view of a graph's hull, published after each batch of mutations.
+struct GraphSnapshot {
+    unsigned long version = 0;
+    HullQueries queries;                      // The hull, indexed for Inside / Extreme / Diameter
+    float area = 0.0f;
+};
+
+// ======== Graph ========
+// One named point set. Writers lock `mutex`, update `points` and `hull`
+// together and bump `version`; publish() then makes the new hull visible,
+// holding `mutex` only to copy the hull and to swap the snapshot in.
+// Readers call current() inside an EpochGuard on the owning registry's
+// epochs() and never lock. Old snapshots wait on the graph's own RetireList,
+// so publishing on one graph never contends with publishing on another.
+class Graph {
+public:
+    explicit Graph(EpochDomain& epochs);
+    ~Graph();
+
+    Graph(const Graph&) = delete;
+    Graph& operator=(const Graph&) = delete;
+
+    void publish();                           // No-op if the snapshot is current; builds it unlocked
+    const GraphSnapshot* current() const { return snapshot.load(std::memory_order_acquire); }
+
+    std::mutex mutex;
+    DynamicHull hull;                         // The points, duplicates counted, and their hull
+    unsigned long version = 0;                // Bumped under mutex by every mutation
+
+private:
+    RetireList retired;                       // Replaced snapshots
+    std::atomic<const GraphSnapshot*> snapshot;
+};
+
+// ======== Registry ========
+// Graphs by name, split over independently locked shards so that looking up
+// unrelated graphs does not serialize. Graphs live as long as the registry,
+// so pointers returned by get() stay valid; at most maxGraphs are created.
+class GraphRegistry {
+public:
+    explicit GraphRegistry(size_t shardCount = 16, size_t maxGraphs = 1024);
+
+    Graph* get(const std::string& name);      // Creates an empty graph on first use; nullptr when full
+    size_t size() const;
+    EpochDomain& epochs() { return epochDomain; }
+
+private:
+    struct alignas(64) Shard {                // One cache line each, so shard locks do not false-share
+        mutable std::mutex mutex;
+        std::unordered_map<std::string, std::unique_ptr<Graph>> graphs;
+    };
+
+    EpochDomain epochDomain;                  // Declared first so it outlives every graph
+    size_t shardCount;
+    size_t maxGraphs;
+    std::atomic<size_t> graphCount{0};        // Reserved before a graph is created
+    std::unique_ptr<Shard[]> shards;
+};
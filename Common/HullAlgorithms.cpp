@@ -0,0 +1,217 @@
+#include "HullAlgorithms.hpp"
+#include "RadixSort.hpp"
+#include "Simd.hpp"
+#include <algorithm>
+
+const char* hullAlgorithmName(HullAlgorithm algorithm) {
+    switch (algorithm) {
+        case QUICKHULL: return "quickhull";
+        case CHAN: return "chan";
+        default: return "monotone chain";
+    }
+}
+
+// Joins a lower chain (left to right) and an upper chain (left to right)
+// into one counter-clockwise polygon
+static std::vector<Point> joinChains(const std::vector<Point>& lower, const std::vector<Point>& upper) {
+    std::vector<Point> H(lower);
+    for (size_t i = upper.size() - 1; i-- > 1; ) H.push_back(upper[i]);
+    return H;
+}
+
+// ========== Quickhull ==========
+
+// Appends the hull vertices strictly right of P -> Q, in order from P to Q.
+// W[lo, hi) holds the candidates; D is scratch space for their orientations.
+static void quickHullSide(std::vector<Point>& W, std::vector<double>& D, size_t lo, size_t hi,
+                          Point P, Point Q, std::vector<Point>& out) {
+    struct Task {
+        size_t lo, hi;
+        Point P, Q;
+        bool emitQ;                           // Emit Q once everything before it is done
+    };
+    std::vector<Task> stack = {{lo, hi, P, Q, false}};
+
+    while (!stack.empty()) {
+        Task t = stack.back();
+        stack.pop_back();
+        if (t.emitQ) {
+            out.push_back(t.Q);
+            continue;
+        }
+        if (t.lo == t.hi) continue;
+
+        // Farthest point right of P -> Q; ties go to the smallest, which is a hull vertex
+        orientBatch(t.P, t.Q, &W[t.lo], t.hi - t.lo, &D[t.lo]);
+        size_t best = t.lo;
+        for (size_t i = t.lo + 1; i < t.hi; ++i) {
+            if (D[i] < D[best] || (D[i] == D[best] && W[i] < W[best])) best = i;
+        }
+        Point C = W[best];
+
+        // Keep the points right of P -> C, then those right of C -> Q
+        orientBatch(t.P, C, &W[t.lo], t.hi - t.lo, &D[t.lo]);
+        size_t mid = t.lo;
+        for (size_t i = t.lo; i < t.hi; ++i) {
+            if (D[i] < 0) std::swap(W[mid++], W[i]);
+        }
+        orientBatch(C, t.Q, &W[mid], t.hi - mid, &D[mid]);
+        size_t end = mid;
+        for (size_t i = mid; i < t.hi; ++i) {
+            if (D[i] < 0) std::swap(W[end++], W[i]);
+        }
+
+        stack.push_back({mid, end, C, t.Q, false});
+        stack.push_back({0, 0, t.P, C, true});
+        stack.push_back({t.lo, mid, t.P, C, false});
+    }
+}
+
+std::vector<Point> quickHull(const std::vector<Point>& P) {
+    if (P.size() <= 1) return P;
+    auto range = std::minmax_element(P.begin(), P.end());
+    Point A = *range.first, B = *range.second;
+    if (A == B) return {A};
+
+    // Split into the points below A -> B and the points above it
+    std::vector<double> D(P.size());
+    orientBatch(A, B, P.data(), P.size(), D.data());
+    std::vector<Point> W;
+    W.reserve(P.size());
+    for (size_t i = 0; i < P.size(); ++i) {
+        if (D[i] < 0) W.push_back(P[i]);
+    }
+    size_t below = W.size();
+    for (size_t i = 0; i < P.size(); ++i) {
+        if (D[i] > 0) W.push_back(P[i]);
+    }
+
+    std::vector<Point> H = {A};
+    quickHullSide(W, D, 0, below, A, B, H);
+    H.push_back(B);
+    quickHullSide(W, D, below, W.size(), B, A, H);
+    return H;
+}
+
+// ========== Chan ==========
+
+// Upper (side = 1) or lower (side = -1) chain of sorted points, left to right
+static void appendChain(const Point* P, size_t n, double side, std::vector<Point>& out) {
+    size_t base = out.size();
+    for (size_t i = 0; i < n; ++i) {
+        if (i > 0 && P[i] == P[i - 1]) continue;
+        while (out.size() - base >= 2 && side * cross(out[out.size() - 2], out.back(), P[i]) >= 0) {
+            out.pop_back();
+        }
+        out.push_back(P[i]);
+    }
+}
+
+// Gift-wraps one chain from the smallest to the largest point, taking the
+// next vertex from every group chain by binary search. Fails after m steps.
+static bool wrapChain(const std::vector<Point>& chains, const std::vector<size_t>& start,
+                      double side, size_t m, std::vector<Point>& out) {
+    size_t groups = start.size() - 1;
+    Point first = chains[start[0]], last = chains[start[0]];
+    for (size_t g = 0; g < groups; ++g) {
+        first = std::min(first, chains[start[g]]);
+        last = std::max(last, chains[start[g + 1] - 1]);
+    }
+
+    out.assign(1, first);
+    Point p = first;
+    while (!(p == last)) {
+        if (out.size() > m) return false;
+        bool found = false;
+        Point q = p;
+        for (size_t g = 0; g < groups; ++g) {
+            // Chain vertices after p; the turn direction along them flips once
+            const Point* c = &chains[start[g]];
+            size_t lo = std::upper_bound(c, c + (start[g + 1] - start[g]), p) - c;
+            size_t hi = start[g + 1] - start[g];
+            if (lo == hi) continue;
+            --hi;
+            while (lo < hi) {
+                size_t mid = (lo + hi) / 2;
+                if (side * cross(p, c[mid], c[mid + 1]) >= 0) lo = mid + 1;
+                else hi = mid;
+            }
+            double turn = found ? side * cross(p, q, c[lo]) : 1.0;
+            if (turn > 0 || (turn == 0 && q < c[lo])) {
+                q = c[lo];
+                found = true;
+            }
+        }
+        out.push_back(q);
+        p = q;
+    }
+    return true;
+}
+
+std::vector<Point> chanHull(std::vector<Point> P) {
+    size_t n = P.size();
+    if (n <= 1) return P;
+
+    std::vector<Point> upperChains, lowerChains, upper, lower;
+    std::vector<size_t> upperStart, lowerStart;
+    for (size_t m = 64; ; m = std::min(n, m * m)) {
+        // Hulls of groups of m points, stored back to back
+        upperChains.clear();
+        lowerChains.clear();
+        upperStart.assign(1, 0);
+        lowerStart.assign(1, 0);
+        for (size_t g = 0; g < n; g += m) {
+            size_t len = std::min(m, n - g);
+            sortPoints(&P[g], len);
+            appendChain(&P[g], len, 1.0, upperChains);
+            appendChain(&P[g], len, -1.0, lowerChains);
+            upperStart.push_back(upperChains.size());
+            lowerStart.push_back(lowerChains.size());
+        }
+
+        if (wrapChain(lowerChains, lowerStart, -1.0, m, lower) &&
+            wrapChain(upperChains, upperStart, 1.0, m, upper)) {
+            break;
+        }
+        if (m >= n) break;                    // One group: the chains are already exact
+    }
+    if (lower.size() == 1) return lower;
+    return joinChains(lower, upper);
+}
+
+// ========== Selection ==========
+
+size_t estimateHullSize(const std::vector<Point>& P, size_t sample) {
+    std::vector<Point> S;
+    if (P.size() <= sample) {
+        S = P;
+    } else {
+        S.reserve(sample);
+        size_t stride = P.size() / sample;
+        for (size_t i = 0; i < sample; ++i) S.push_back(P[i * stride]);
+    }
+    sortPoints(S.data(), S.size());
+    return hullOfSorted(S.data(), S.size()).size();
+}
+
+HullAlgorithm selectHullAlgorithm(const std::vector<Point>& P) {
+    const size_t sample = 1024;
+    if (P.size() < kRadixSortThreshold) return MONOTONE_CHAIN;
+
+    // Most of the sample on its hull: the input is near convex position and
+    // sorting is optimal. Otherwise Quickhull discards the interior fastest;
+    // Chan's group sorts cost more than its better worst case saves here.
+    size_t h = estimateHullSize(P, sample);
+    return h * 8 >= sample ? MONOTONE_CHAIN : QUICKHULL;
+}
+
+std::vector<Point> runHullAlgorithm(HullAlgorithm algorithm, std::vector<Point> P) {
+    switch (algorithm) {
+        case QUICKHULL: return quickHull(P);
+        case CHAN: return chanHull(std::move(P));
+        default:
+            if (P.size() <= 1) return P;
+            sortPoints(P);
+            return hullOfSorted(P.data(), P.size());
+    }
+}
@@ -0,0 +1,28 @@
+#pragma once
+#include "Geometry.hpp"
+#include <vector>
+#include <cstddef>
+
+// ======== Hull algorithms ========
+// All of them return the hull counter-clockwise from the smallest point in (x, y)
+// order without collinear vertices, like convexHull().
+
+enum HullAlgorithm {
+    MONOTONE_CHAIN,                           // O(n log n), or O(n) with radix sort
+    QUICKHULL,                                // Expected O(n log h), worst case O(n^2)
+    CHAN                                      // O(n log h) worst case
+};
+
+const char* hullAlgorithmName(HullAlgorithm algorithm);
+
+std::vector<Point> quickHull(const std::vector<Point>& P);
+std::vector<Point> chanHull(std::vector<Point> P);
+
+// Hull size of an evenly strided sample of at most `sample` points
+size_t estimateHullSize(const std::vector<Point>& P, size_t sample = 1024);
+
+// Picks the algorithm expected to be fastest from a sample estimate of h
+// (monotone chain when the input is near convex position, Quickhull otherwise)
+HullAlgorithm selectHullAlgorithm(const std::vector<Point>& P);
+
+std::vector<Point> runHullAlgorithm(HullAlgorithm algorithm, std::vector<Point> P);
@@ -0,0 +1,94 @@
+#include "HullQueries.hpp"
+#include <algorithm>
+#include <cmath>
+
+static const double kTwoPi = 6.28318530717958647692;
+
+static inline double dist(const Point& a, const Point& b) {
+    return std::hypot(static_cast<double>(a.x) - b.x, static_cast<double>(a.y) - b.y);
+}
+
+void HullQueries::build(const std::vector<Point>& h) {
+    hull = h;
+    edgeAngle.clear();
+    size_t n = hull.size();
+    if (n >= 2) {
+        // Turning counter-clockwise, each edge points further round than the last
+        for (size_t i = 0; i < n; ++i) {
+            const Point& a = hull[i];
+            const Point& b = hull[(i + 1) % n];
+            double angle = std::atan2(static_cast<double>(b.y) - a.y, static_cast<double>(b.x) - a.x);
+            if (i > 0) {
+                while (angle < edgeAngle.back()) angle += kTwoPi;
+            }
+            edgeAngle.push_back(angle);
+        }
+    }
+    calipers();
+}
+
+bool HullQueries::inside(const Point& p) const {
+    size_t n = hull.size();
+    if (n == 0) return false;
+    if (n == 1) return p == hull[0];
+    if (n == 2) {
+        return cross(hull[0], hull[1], p) == 0 &&
+               std::min(hull[0].x, hull[1].x) <= p.x && p.x <= std::max(hull[0].x, hull[1].x) &&
+               std::min(hull[0].y, hull[1].y) <= p.y && p.y <= std::max(hull[0].y, hull[1].y);
+    }
+
+    // Binary search for the fan triangle (hull[0], hull[lo], hull[lo + 1]) holding p
+    const Point& o = hull[0];
+    if (cross(o, hull[1], p) < 0 || cross(o, hull[n - 1], p) > 0) return false;
+    size_t lo = 1, hi = n - 1;
+    while (hi - lo > 1) {
+        size_t mid = (lo + hi) / 2;
+        if (cross(o, hull[mid], p) >= 0) lo = mid;
+        else hi = mid;
+    }
+    return cross(hull[lo], hull[lo + 1], p) >= 0;
+}
+
+Point HullQueries::extreme(double dx, double dy) const {
+    size_t n = hull.size();
+    if (n == 1) return hull[0];
+
+    // The extreme vertex is where the edges turn past the direction's left normal
+    double target = std::atan2(dy, dx) + kTwoPi / 4;
+    while (target < edgeAngle[0]) target += kTwoPi;
+    while (target >= edgeAngle[0] + kTwoPi) target -= kTwoPi;
+    size_t i = std::lower_bound(edgeAngle.begin(), edgeAngle.end(), target) - edgeAngle.begin();
+    return hull[i == n ? 0 : i];
+}
+
+// Rotating calipers: walks every edge with its farthest (antipodal) vertex
+void HullQueries::calipers() {
+    size_t n = hull.size();
+    diam = minWidth = 0.0;
+    if (n == 0) return;
+    diamA = diamB = hull[0];
+    if (n == 1) return;
+    if (n == 2) {
+        diam = dist(hull[0], hull[1]);
+        diamB = hull[1];
+        return;
+    }
+
+    minWidth = INFINITY;
+    size_t j = 1;
+    for (size_t i = 0; i < n; ++i) {
+        const Point& a = hull[i];
+        const Point& b = hull[(i + 1) % n];
+        while (cross(a, b, hull[(j + 1) % n]) > cross(a, b, hull[j])) j = (j + 1) % n;
+
+        minWidth = std::min(minWidth, cross(a, b, hull[j]) / dist(a, b));
+        for (const Point* e : {&a, &b}) {
+            double d = dist(*e, hull[j]);
+            if (d > diam) {
+                diam = d;
+                diamA = *e;
+                diamB = hull[j];
+            }
+        }
+    }
+}
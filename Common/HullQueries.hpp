@@ -0,0 +1,30 @@
+#pragma once
+#include "Geometry.hpp"
+#include <vector>
+#include <cstddef>
+
+// Queries against one convex hull, in the order convexHull() returns it
+// (counter-clockwise from the smallest point, no collinear vertices).
+// build() is O(h); afterwards inside() and extreme() are O(log h) binary
+// searches and the rotating-calipers diameter and width are O(1).
+class HullQueries {
+public:
+    void build(const std::vector<Point>& hull);
+
+    bool empty() const { return hull.empty(); }
+    const std::vector<Point>& vertices() const { return hull; }
+    bool inside(const Point& p) const;                 // Boundary counts as inside
+    Point extreme(double dx, double dy) const;         // Max dot product with (dx, dy); hull must be non-empty
+    double diameter() const { return diam; }           // Largest distance between two points
+    double width() const { return minWidth; }          // Smallest distance between parallel supporting lines
+    Point diameterA() const { return diamA; }          // Endpoints of a diameter
+    Point diameterB() const { return diamB; }
+
+private:
+    void calipers();
+
+    std::vector<Point> hull;
+    std::vector<double> edgeAngle;            // Direction of edge i -> i + 1, unwrapped to increase
+    double diam = 0.0, minWidth = 0.0;
+    Point diamA = {0, 0}, diamB = {0, 0};
+};
@@ -0,0 +1,76 @@
+#include "ParallelHull.hpp"
+#include "RadixSort.hpp"
+#include <algorithm>
+#include <thread>
+
+// Below this many points per thread, spawning threads costs more than it saves
+static const size_t kMinSlice = 1 << 14;
+
+unsigned hullThreads() {
+    unsigned n = std::thread::hardware_concurrency();
+    return n == 0 ? 1 : n;
+}
+
+static unsigned sliceCount(size_t n, unsigned threads) {
+    if (threads == 0) threads = hullThreads();
+    size_t maxSlices = std::max<size_t>(1, n / kMinSlice);
+    return static_cast<unsigned>(std::min<size_t>(threads, maxSlices));
+}
+
+void parallelSort(std::vector<Point>& P, unsigned threads) {
+    unsigned T = sliceCount(P.size(), threads);
+    if (T <= 1) {
+        std::sort(P.begin(), P.end());
+        return;
+    }
+
+    // Slice boundaries: slice t is [bounds[t], bounds[t + 1])
+    std::vector<size_t> bounds(T + 1);
+    for (unsigned t = 0; t <= T; ++t) bounds[t] = P.size() * t / T;
+
+    std::vector<std::thread> workers;
+    for (unsigned t = 0; t < T; ++t) {
+        workers.emplace_back([&P, &bounds, t] {
+            std::sort(P.begin() + bounds[t], P.begin() + bounds[t + 1]);
+        });
+    }
+    for (auto& w : workers) w.join();
+
+    // Merge neighbouring runs, doubling the run width each round
+    for (unsigned width = 1; width < T; width *= 2) {
+        workers.clear();
+        for (unsigned t = 0; t + width < T; t += 2 * width) {
+            size_t lo = bounds[t], mid = bounds[t + width], hi = bounds[std::min(t + 2 * width, T)];
+            workers.emplace_back([&P, lo, mid, hi] {
+                std::inplace_merge(P.begin() + lo, P.begin() + mid, P.begin() + hi);
+            });
+        }
+        for (auto& w : workers) w.join();
+    }
+}
+
+std::vector<Point> parallelConvexHull(std::vector<Point> P, unsigned threads) {
+    unsigned T = sliceCount(P.size(), threads);
+    if (T <= 1) {
+        sortPoints(P);
+        return hullOfSorted(P.data(), P.size());
+    }
+
+    std::vector<std::vector<Point>> partial(T);
+    std::vector<std::thread> workers;
+    for (unsigned t = 0; t < T; ++t) {
+        workers.emplace_back([&P, &partial, t, T] {
+            auto first = P.begin() + P.size() * t / T;
+            auto last = P.begin() + P.size() * (t + 1) / T;
+            sortPoints(&*first, last - first);
+            partial[t] = hullOfSorted(&*first, last - first);
+        });
+    }
+    for (auto& w : workers) w.join();
+
+    // The hull of the union is the hull of the partial hull vertices
+    std::vector<Point> candidates;
+    for (const auto& h : partial) candidates.insert(candidates.end(), h.begin(), h.end());
+    sortPoints(candidates);
+    return hullOfSorted(candidates.data(), candidates.size());
+}
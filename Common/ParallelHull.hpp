@@ -0,0 +1,17 @@
+#pragma once
+#include "Geometry.hpp"
+#include <vector>
+#include <cstddef>
+
+// convexHull() switches to the parallel engine from this many points on
+const size_t kParallelHullThreshold = 1 << 17;
+
+unsigned hullThreads();                                          // Worker count (hardware threads)
+
+// Sorts by (x, y): slices are sorted concurrently, then merged pairwise in parallel
+void parallelSort(std::vector<Point>& P, unsigned threads = 0);
+
+// Divide and conquer: one partial hull per slice, computed concurrently,
+// then a single monotone chain over the union of the partial hull vertices.
+// Slices and the merged candidates are sorted with sortPoints().
+std::vector<Point> parallelConvexHull(std::vector<Point> P, unsigned threads = 0);
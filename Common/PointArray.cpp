@@ -0,0 +1,68 @@
+#include "PointArray.hpp"
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <utility>
+
+static const size_t kAlignment = 64;          // One cache line, two AVX2 registers
+
+static float* allocateStream(size_t n) {
+    size_t bytes = (n * sizeof(float) + kAlignment - 1) / kAlignment * kAlignment;
+    void* p = std::aligned_alloc(kAlignment, bytes);
+    if (!p) throw std::bad_alloc();
+    return static_cast<float*>(p);
+}
+
+PointArray::PointArray(const PointArray& other) {
+    reserve(other.count);
+    std::memcpy(xs, other.xs, other.count * sizeof(float));
+    std::memcpy(ys, other.ys, other.count * sizeof(float));
+    count = other.count;
+}
+
+PointArray::PointArray(PointArray&& other) noexcept
+    : xs(other.xs), ys(other.ys), count(other.count), capacity(other.capacity) {
+    other.xs = other.ys = nullptr;
+    other.count = other.capacity = 0;
+}
+
+PointArray& PointArray::operator=(PointArray other) noexcept {
+    std::swap(xs, other.xs);
+    std::swap(ys, other.ys);
+    std::swap(count, other.count);
+    std::swap(capacity, other.capacity);
+    return *this;
+}
+
+PointArray::~PointArray() {
+    std::free(xs);
+    std::free(ys);
+}
+
+void PointArray::reserve(size_t n) {
+    if (n <= capacity) return;
+    float* nx = allocateStream(n);
+    float* ny = allocateStream(n);
+    if (count) {
+        std::memcpy(nx, xs, count * sizeof(float));
+        std::memcpy(ny, ys, count * sizeof(float));
+    }
+    std::free(xs);
+    std::free(ys);
+    xs = nx;
+    ys = ny;
+    capacity = n;
+}
+
+void PointArray::push_back(const Point& p) {
+    if (count == capacity) reserve(capacity ? capacity * 2 : 16);
+    xs[count] = p.x;
+    ys[count] = p.y;
+    ++count;
+}
+
+std::vector<Point> PointArray::snapshot() const {
+    std::vector<Point> points(count);
+    for (size_t i = 0; i < count; ++i) points[i] = {xs[i], ys[i]};
+    return points;
+}
@@ -0,0 +1,34 @@
+#pragma once
+#include "Geometry.hpp"
+#include <vector>
+#include <cstddef>
+
+// Points stored as two coordinate streams, x[] and y[] (structure of arrays),
+// each 64-byte aligned, so batch kernels load eight x or eight y values per
+// AVX2 register without shuffling interleaved pairs apart. Only the Stage 2
+// bench fills one, to time convexHull() over SoA input; the servers keep their
+// points in DynamicHull. It therefore only grows and is read.
+class PointArray {
+public:
+    PointArray() = default;
+    PointArray(const PointArray& other);
+    PointArray(PointArray&& other) noexcept;
+    PointArray& operator=(PointArray other) noexcept;
+    ~PointArray();
+
+    void reserve(size_t n);
+    void push_back(const Point& p);
+
+    Point operator[](size_t i) const { return {xs[i], ys[i]}; }
+    size_t size() const { return count; }
+    const float* x() const { return xs; }
+    const float* y() const { return ys; }
+
+    std::vector<Point> snapshot() const;      // Interleaved copy, same order
+
+private:
+    float* xs = nullptr;
+    float* ys = nullptr;
+    size_t count = 0;
+    size_t capacity = 0;
+};
@@ -0,0 +1,195 @@
+#include "PointFile.hpp"
+#include <algorithm>
+#include <cstring>
+
+static const char kMagic[4] = {'C', 'H', 'P', 'T'};
+
+// ========== Little-endian encoding ==========
+
+static inline uint32_t floatBits(float f) {
+    uint32_t u;
+    std::memcpy(&u, &f, 4);
+    return u;
+}
+
+static inline float bitsFloat(uint32_t u) {
+    float f;
+    std::memcpy(&f, &u, 4);
+    return f;
+}
+
+static inline void putLE(unsigned char* dst, uint64_t v, int bytes) {
+    for (int i = 0; i < bytes; ++i) dst[i] = static_cast<unsigned char>(v >> (8 * i));
+}
+
+static inline uint64_t getLE(const char* src, int bytes) {
+    uint64_t v = 0;
+    for (int i = 0; i < bytes; ++i) v |= uint64_t(static_cast<unsigned char>(src[i])) << (8 * i);
+    return v;
+}
+
+static inline float getFloat(const char* src) {
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    float f;
+    std::memcpy(&f, src, 4);
+    return f;
+#else
+    return bitsFloat(static_cast<uint32_t>(getLE(src, 4)));
+#endif
+}
+
+static void encodeHeader(const PointFileHeader& h, unsigned char* dst) {
+    std::memset(dst, 0, kPointFileHeaderSize);
+    std::memcpy(dst, kMagic, 4);
+    putLE(dst + 4, h.version, 2);
+    putLE(dst + 6, h.layout, 2);
+    putLE(dst + 8, h.count, 8);
+    putLE(dst + 16, floatBits(h.minX), 4);
+    putLE(dst + 20, floatBits(h.minY), 4);
+    putLE(dst + 24, floatBits(h.maxX), 4);
+    putLE(dst + 28, floatBits(h.maxY), 4);
+    putLE(dst + 32, h.blockSize, 4);
+}
+
+// ========== Reading ==========
+
+bool isBinaryPointFile(const char* data, size_t size) {
+    return size >= 4 && std::memcmp(data, kMagic, 4) == 0;
+}
+
+bool readPointFileHeader(const char* data, size_t size, PointFileHeader& h) {
+    if (size < kPointFileHeaderSize || !isBinaryPointFile(data, size)) return false;
+    h.version = static_cast<uint16_t>(getLE(data + 4, 2));
+    uint16_t layout = static_cast<uint16_t>(getLE(data + 6, 2));
+    h.count = getLE(data + 8, 8);
+    h.minX = getFloat(data + 16);
+    h.minY = getFloat(data + 20);
+    h.maxX = getFloat(data + 24);
+    h.maxY = getFloat(data + 28);
+    h.blockSize = static_cast<uint32_t>(getLE(data + 32, 4));
+
+    if (h.version != kPointFileVersion) return false;
+    if (layout != INTERLEAVED && layout != SOA_BLOCKS) return false;
+    h.layout = static_cast<PointLayout>(layout);
+    if (h.layout == SOA_BLOCKS && h.blockSize == 0) return false;
+    return h.count <= (size - kPointFileHeaderSize) / sizeof(Point);
+}
+
+const Point* pointFileData(const char* data, const PointFileHeader& h) {
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    if (h.layout == INTERLEAVED) return reinterpret_cast<const Point*>(data + kPointFileHeaderSize);
+#endif
+    (void)data;
+    (void)h;
+    return nullptr;
+}
+
+void decodePointFile(const char* data, const PointFileHeader& h, Point* out) {
+    if (const Point* in = pointFileData(data, h)) {
+        std::memcpy(out, in, h.count * sizeof(Point));
+    } else {
+        decodePointRange(data, h, 0, h.count, out);
+    }
+}
+
+void decodePointRange(const char* data, const PointFileHeader& h, uint64_t first, size_t count, Point* out) {
+    const char* payload = data + kPointFileHeaderSize;
+    if (h.layout == INTERLEAVED) {
+        decodePoints(payload + 8 * first, count, out);
+        return;
+    }
+    while (count > 0) {
+        uint64_t start = first - first % h.blockSize;    // The block holding point first
+        uint64_t len = std::min<uint64_t>(h.blockSize, h.count - start);
+        size_t take = static_cast<size_t>(std::min<uint64_t>(count, start + len - first));
+        const char* xs = payload + 8 * start + 4 * (first - start);
+        const char* ys = xs + 4 * len;
+        for (size_t i = 0; i < take; ++i) {
+            out[i].x = getFloat(xs + 4 * i);
+            out[i].y = getFloat(ys + 4 * i);
+        }
+        first += take;
+        count -= take;
+        out += take;
+    }
+}
+
+void decodePoints(const char* data, size_t count, Point* out) {
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    std::memcpy(out, data, count * sizeof(Point));
+#else
+    for (size_t i = 0; i < count; ++i) {
+        out[i].x = getFloat(data + 8 * i);
+        out[i].y = getFloat(data + 8 * i + 4);
+    }
+#endif
+}
+
+// ========== PointFileWriter ==========
+
+PointFileWriter::PointFileWriter(const std::string& path, PointLayout layout, uint32_t blockSize) {
+    header.layout = layout;
+    header.blockSize = layout == SOA_BLOCKS ? std::max<uint32_t>(blockSize, 1) : 0;
+    out = std::fopen(path.c_str(), "wb");
+    if (!out) return;
+    std::setvbuf(out, nullptr, _IOFBF, 1 << 20);
+    unsigned char raw[kPointFileHeaderSize];
+    encodeHeader(header, raw);               // Placeholder until close()
+    failed = std::fwrite(raw, 1, sizeof(raw), out) != sizeof(raw);
+    if (layout == SOA_BLOCKS) {
+        xs.reserve(header.blockSize);
+        ys.reserve(header.blockSize);
+    }
+}
+
+PointFileWriter::~PointFileWriter() {
+    close();
+}
+
+void PointFileWriter::add(const Point& p) {
+    if (!out) return;
+    if (header.count == 0) {
+        header.minX = header.maxX = p.x;
+        header.minY = header.maxY = p.y;
+    } else {
+        header.minX = std::min(header.minX, p.x);
+        header.maxX = std::max(header.maxX, p.x);
+        header.minY = std::min(header.minY, p.y);
+        header.maxY = std::max(header.maxY, p.y);
+    }
+    ++header.count;
+
+    if (header.layout == INTERLEAVED) {
+        unsigned char raw[8];
+        putLE(raw, floatBits(p.x), 4);
+        putLE(raw + 4, floatBits(p.y), 4);
+        failed |= std::fwrite(raw, 1, 8, out) != 8;
+    } else {
+        xs.push_back(p.x);
+        ys.push_back(p.y);
+        if (xs.size() == header.blockSize) flushBlock();
+    }
+}
+
+void PointFileWriter::flushBlock() {
+    std::vector<unsigned char> raw(8 * xs.size());
+    for (size_t i = 0; i < xs.size(); ++i) {
+        putLE(&raw[4 * i], floatBits(xs[i]), 4);
+        putLE(&raw[4 * (xs.size() + i)], floatBits(ys[i]), 4);
+    }
+    failed |= std::fwrite(raw.data(), 1, raw.size(), out) != raw.size();
+    xs.clear();
+    ys.clear();
+}
+
+bool PointFileWriter::close() {
+    if (!out) return !failed;
+    if (!xs.empty()) flushBlock();
+    unsigned char raw[kPointFileHeaderSize];
+    encodeHeader(header, raw);
+    failed |= std::fseek(out, 0, SEEK_SET) != 0;
+    failed |= std::fwrite(raw, 1, sizeof(raw), out) != sizeof(raw);
+    failed |= std::fclose(out) != 0;
+    out = nullptr;
+    return !failed;
+}
@@ -0,0 +1,72 @@
+#pragma once
+#include "Geometry.hpp"
+#include <cstdio>
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// ======== Binary point file ========
+// A 40-byte little-endian header followed by the points as 32-bit floats:
+//   "CHPT", u16 version, u16 layout, u64 count,
+//   f32 minX, minY, maxX, maxY (bounding box), u32 block size, u32 reserved
+// INTERLEAVED stores x0 y0 x1 y1 ...; SOA_BLOCKS stores each block of up to
+// blockSize points as all its x values followed by all its y values.
+
+enum PointLayout : uint16_t { INTERLEAVED = 0, SOA_BLOCKS = 1 };
+
+const uint16_t kPointFileVersion = 1;
+const size_t kPointFileHeaderSize = 40;
+
+struct PointFileHeader {
+    uint16_t version = kPointFileVersion;
+    PointLayout layout = INTERLEAVED;
+    uint64_t count = 0;
+    float minX = 0, minY = 0, maxX = 0, maxY = 0;
+    uint32_t blockSize = 0;                   // Points per SoA block, 0 when interleaved
+};
+
+bool isBinaryPointFile(const char* data, size_t size);     // Checks the magic only
+
+// Decodes and validates the header: version, layout and payload size
+bool readPointFileHeader(const char* data, size_t size, PointFileHeader& h);
+
+// The points of an interleaved file, read in place on little-endian hosts;
+// nullptr when the layout or byte order needs decoding
+const Point* pointFileData(const char* data, const PointFileHeader& h);
+
+// Decodes any layout into out, which must hold h.count points
+void decodePointFile(const char* data, const PointFileHeader& h, Point* out);
+
+// Decodes points [first, first + count) of any layout, so a file can be read
+// a bounded buffer at a time; the range must lie within h.count
+void decodePointRange(const char* data, const PointFileHeader& h, uint64_t first, size_t count, Point* out);
+
+// Decodes count interleaved little-endian points (x0 y0 x1 y1 ...), as used by
+// the payload above and by binary uploads to the servers
+void decodePoints(const char* data, size_t count, Point* out);
+
+// ======== Writer ========
+// Streams points to a binary file. The header is rewritten on close, once the
+// count and bounding box are known, so the point count need not be known up front.
+class PointFileWriter {
+public:
+    explicit PointFileWriter(const std::string& path, PointLayout layout = INTERLEAVED,
+                             uint32_t blockSize = 1 << 16);
+    ~PointFileWriter();
+
+    PointFileWriter(const PointFileWriter&) = delete;
+    PointFileWriter& operator=(const PointFileWriter&) = delete;
+
+    bool valid() const { return out != nullptr; }
+    void add(const Point& p);
+    bool close();                             // False if any write failed
+
+private:
+    void flushBlock();
+
+    FILE* out = nullptr;
+    PointFileHeader header;
+    std::vector<float> xs, ys;                // Pending SoA block
+    bool failed = false;
+};
@@ -0,0 +1,87 @@
+#include "PointGenerator.hpp"
+#include <cmath>
+
+static const double kPi = 3.14159265358979323846;
+static const int kClusters = 8;
+
+const char* distributionName(Distribution d) {
+    switch (d) {
+        case UNIFORM_SQUARE:    return "square";
+        case UNIFORM_DISK:      return "disk";
+        case CIRCLE:            return "circle";
+        case GAUSSIAN_CLUSTERS: return "clusters";
+        case NEAR_COLLINEAR:    return "collinear";
+    }
+    return "?";
+}
+
+bool parseDistribution(const std::string& name, Distribution& d) {
+    for (Distribution candidate : kDistributions) {
+        if (name == distributionName(candidate)) {
+            d = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
+PointGenerator::PointGenerator(Distribution d, uint64_t seed) : dist(d), rng(seed) {
+    if (dist == GAUSSIAN_CLUSTERS) {
+        for (int i = 0; i < kClusters; ++i) {
+            float x = static_cast<float>(100.0 + 800.0 * unit());
+            float y = static_cast<float>(100.0 + 800.0 * unit());
+            centers.push_back({x, y});
+        }
+    }
+}
+
+double PointGenerator::unit() {
+    return (rng() >> 11) * (1.0 / 9007199254740992.0);   // 53 random bits / 2^53
+}
+
+double PointGenerator::normal() {
+    double u = 1.0 - unit();                  // (0, 1], keeps the log finite
+    return std::sqrt(-2.0 * std::log(u)) * std::cos(2.0 * kPi * unit());
+}
+
+Point PointGenerator::next() {
+    double x = 0, y = 0;
+    switch (dist) {
+        case UNIFORM_SQUARE:
+            x = 1000.0 * unit();
+            y = 1000.0 * unit();
+            break;
+        case UNIFORM_DISK: {
+            double r = 500.0 * std::sqrt(unit());
+            double a = 2.0 * kPi * unit();
+            x = 500.0 + r * std::cos(a);
+            y = 500.0 + r * std::sin(a);
+            break;
+        }
+        case CIRCLE: {
+            double a = 2.0 * kPi * unit();
+            x = 500.0 + 500.0 * std::cos(a);
+            y = 500.0 + 500.0 * std::sin(a);
+            break;
+        }
+        case GAUSSIAN_CLUSTERS: {
+            const Point& c = centers[rng() % kClusters];
+            x = c.x + 20.0 * normal();
+            y = c.y + 20.0 * normal();
+            break;
+        }
+        case NEAR_COLLINEAR:
+            x = 1000.0 * unit();
+            y = 0.5 * x + 1e-3 * (unit() - 0.5);
+            break;
+    }
+    return {static_cast<float>(x), static_cast<float>(y)};
+}
+
+std::vector<Point> generatePoints(Distribution d, size_t n, uint64_t seed) {
+    PointGenerator gen(d, seed);
+    std::vector<Point> points;
+    points.reserve(n);
+    for (size_t i = 0; i < n; ++i) points.push_back(gen.next());
+    return points;
+}
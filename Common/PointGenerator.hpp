@@ -0,0 +1,46 @@
+#pragma once
+#include "Geometry.hpp"
+#include <cstdint>
+#include <cstddef>
+#include <random>
+#include <string>
+#include <vector>
+
+// ======== Point distributions ========
+// Hull algorithms behave very differently depending on how many points end
+// up on the hull, so workloads cover the extremes as well as the usual case.
+enum Distribution {
+    UNIFORM_SQUARE,                           // [0, 1000)^2, h ~ log n
+    UNIFORM_DISK,                             // Disk of radius 500, h ~ n^(1/3)
+    CIRCLE,                                   // On a circle of radius 500, h ~ n
+    GAUSSIAN_CLUSTERS,                        // 8 clusters with sigma 20
+    NEAR_COLLINEAR                            // Along y = x / 2 with 1e-3 noise
+};
+
+const Distribution kDistributions[] = {UNIFORM_SQUARE, UNIFORM_DISK, CIRCLE, GAUSSIAN_CLUSTERS, NEAR_COLLINEAR};
+
+const char* distributionName(Distribution d);                      // "square", "disk", ...
+bool parseDistribution(const std::string& name, Distribution& d);
+
+// ======== Generator ========
+// Deterministic for a given (distribution, seed) and standard library. The
+// mt19937_64 output is fixed by the standard, and square and collinear use
+// only exactly rounded arithmetic on it, so they match on every platform.
+// Disk, circle and clusters also go through libm log, cos and sin, which are
+// not correctly rounded and may differ in the last bit between libm versions.
+class PointGenerator {
+public:
+    PointGenerator(Distribution d, uint64_t seed);
+
+    Point next();
+
+private:
+    double unit();                            // Uniform in [0, 1)
+    double normal();                          // Standard normal (Box-Muller)
+
+    Distribution dist;
+    std::mt19937_64 rng;
+    std::vector<Point> centers;               // GAUSSIAN_CLUSTERS only
+};
+
+std::vector<Point> generatePoints(Distribution d, size_t n, uint64_t seed);
@@ -0,0 +1,157 @@
+#include "PointLoader.hpp"
+#include "PointParser.hpp"
+#include "PointFile.hpp"
+#include "ParallelHull.hpp"
+#include <algorithm>
+#include <cstring>
+#include <thread>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+// Below this many bytes per thread, one thread parses faster than several
+static const size_t kMinPieceBytes = 1 << 22;
+
+// ========== MappedFile ==========
+
+MappedFile::MappedFile(const std::string& path) {
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) return;
+    map(fd);
+    close(fd);                                // The mapping outlives the descriptor
+}
+
+MappedFile::MappedFile(int fd) {
+    map(fd);
+}
+
+MappedFile::~MappedFile() {
+    if (base) munmap(base, length);
+}
+
+void MappedFile::map(int fd) {
+    struct stat st;
+    if (fstat(fd, &st) < 0 || !S_ISREG(st.st_mode) || st.st_size == 0) return;
+    void* p = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (p == MAP_FAILED) return;
+    madvise(p, st.st_size, MADV_SEQUENTIAL);
+    base = p;
+    length = st.st_size;
+}
+
+// ========== Loading ==========
+
+static inline const char* lineEnd(const char* cur, const char* end) {
+    const char* nl = static_cast<const char*>(std::memchr(cur, '\n', end - cur));
+    return nl ? nl : end;
+}
+
+static inline bool blankLine(const char* cur, const char* end) {
+    for (; cur < end; ++cur) {
+        if (*cur != ' ' && *cur != '\t' && *cur != '\r') return false;
+    }
+    return true;
+}
+
+// Parses every non-blank line of [cur, end) into out; false on a malformed line
+static bool parseLines(const char* cur, const char* end, Point* out, size_t& count) {
+    count = 0;
+    while (cur < end) {
+        const char* last = lineEnd(cur, end);
+        if (!blankLine(cur, last)) {
+            if (!parsePoint(cur, last, out[count])) return false;
+            ++count;
+        }
+        if (last == end) break;
+        cur = last + 1;
+    }
+    return true;
+}
+
+bool loadPoints(const MappedFile& file, std::vector<Point>& points, unsigned threads) {
+    points.clear();
+    if (!file.valid()) return false;
+    const char* cur = file.data();
+    const char* end = cur + file.size();
+
+    if (isBinaryPointFile(cur, file.size())) {
+        PointFileHeader h;
+        if (!readPointFileHeader(cur, file.size(), h)) return false;
+        points.resize(h.count);
+        decodePointFile(cur, h, points.data());
+        return allFinite(points);             // Text input rejects NaN and inf in parsePoint()
+    }
+
+    // Count line, skipping leading blank lines
+    long long n = 0;
+    const char* last = lineEnd(cur, end);
+    while (last < end && blankLine(cur, last)) {
+        cur = last + 1;
+        last = lineEnd(cur, end);
+    }
+    if (!parseCount(cur, last, n) || n < 0) return false;
+    const char* body = std::min(last + 1, end);
+
+    // Pieces start just past a newline, so no line is split between threads
+    if (threads == 0) threads = hullThreads();
+    size_t bytes = end - body;
+    unsigned T = static_cast<unsigned>(std::max<size_t>(1, std::min<size_t>(threads, bytes / kMinPieceBytes)));
+    std::vector<const char*> bounds(T + 1);
+    bounds[0] = body;
+    bounds[T] = end;
+    for (unsigned t = 1; t < T; ++t) {
+        const char* b = std::max(body + bytes * t / T, bounds[t - 1]);
+        bounds[t] = std::min(lineEnd(b, end) + 1, end);
+    }
+
+    // Each piece gets room for one point per line, found by counting newlines
+    std::vector<size_t> offset(T + 1, 0);
+    for (unsigned t = 0; t < T; ++t) {
+        offset[t + 1] = offset[t] + std::count(bounds[t], bounds[t + 1], '\n') + 1;
+    }
+    points.resize(offset[T]);
+
+    std::vector<size_t> parsed(T, 0);
+    std::vector<char> ok(T, 1);
+    auto parsePiece = [&](unsigned t) {
+        ok[t] = parseLines(bounds[t], bounds[t + 1], points.data() + offset[t], parsed[t]);
+    };
+    if (T == 1) {
+        parsePiece(0);
+    } else {
+        std::vector<std::thread> workers;
+        for (unsigned t = 0; t < T; ++t) workers.emplace_back(parsePiece, t);
+        for (auto& w : workers) w.join();
+    }
+
+    // Close the gaps left by blank lines, stopping at the first bad piece
+    size_t total = 0;
+    bool good = true;
+    for (unsigned t = 0; t < T && good; ++t) {
+        if (total != offset[t]) {
+            std::memmove(points.data() + total, points.data() + offset[t], parsed[t] * sizeof(Point));
+        }
+        total += parsed[t];
+        good = ok[t] != 0;
+    }
+    points.resize(std::min<size_t>(total, n));
+    return good;
+}
+
+const Point* mappedPoints(const MappedFile& file, size_t& count) {
+    PointFileHeader h;
+    if (!file.valid() || !readPointFileHeader(file.data(), file.size(), h)) return nullptr;
+    const Point* P = pointFileData(file.data(), h);
+    if (!P) return nullptr;
+    for (size_t i = 0; i < h.count; ++i) {
+        if (!isFinite(P[i])) return nullptr;
+    }
+    count = h.count;
+    return P;
+}
+
+bool loadPointFile(const std::string& path, std::vector<Point>& points, unsigned threads) {
+    MappedFile file(path);
+    return loadPoints(file, points, threads);
+}
@@ -0,0 +1,45 @@
+#pragma once
+#include "Geometry.hpp"
+#include <vector>
+#include <string>
+#include <cstddef>
+
+// ======== Mapped file ========
+// Read-only private mapping of a whole file, advised for sequential access.
+// Empty files and files that cannot be mapped (pipes, terminals) are invalid.
+class MappedFile {
+public:
+    explicit MappedFile(const std::string& path);
+    explicit MappedFile(int fd);               // Maps an already open descriptor, which stays open
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool valid() const { return base != nullptr; }
+    const char* data() const { return static_cast<const char*>(base); }
+    size_t size() const { return length; }
+
+private:
+    void map(int fd);
+
+    void* base = nullptr;
+    size_t length = 0;
+};
+
+// ======== Loading ========
+// The format is detected from the first bytes: binary point files (PointFile.hpp)
+// are decoded directly; text files ("n" + one point per line) are parsed
+// straight from the mapping, split at line boundaries and parsed by several
+// threads into one preallocated array when large. Returns false if the file
+// is neither format, a point line is malformed or a binary point is NaN or
+// infinite; points read so far are kept.
+bool loadPoints(const MappedFile& file, std::vector<Point>& points, unsigned threads = 0);
+
+// Zero-copy view of an interleaved binary file: the points as they sit in
+// the mapping. nullptr for text, SoA or big-endian files (use loadPoints())
+// and for files holding a NaN or infinite coordinate.
+const Point* mappedPoints(const MappedFile& file, size_t& count);
+
+// Maps and loads a file; false if it cannot be opened or does not parse
+bool loadPointFile(const std::string& path, std::vector<Point>& points, unsigned threads = 0);
@@ -0,0 +1,91 @@
+#include "PointParser.hpp"
+#include <charconv>
+#include <cmath>
+#include <cstring>
+
+static inline bool isBlank(char c) {
+    return c == ' ' || c == '\t' || c == '\r';
+}
+
+static inline const char* skipBlanks(const char* cur, const char* end) {
+    while (cur < end && isBlank(*cur)) ++cur;
+    return cur;
+}
+
+// ========== In-place parsing ==========
+
+const char* parseFloat(const char* cur, const char* end, float& out) {
+    cur = skipBlanks(cur, end);
+    if (cur < end && *cur == '+') ++cur;      // from_chars rejects an explicit plus sign
+    auto result = std::from_chars(cur, end, out);
+    // from_chars also takes "nan" and "inf", which no point may hold
+    if (result.ec != std::errc() || !std::isfinite(out)) return nullptr;
+    return result.ptr;
+}
+
+const char* parseCount(const char* cur, const char* end, long long& out) {
+    cur = skipBlanks(cur, end);
+    if (cur < end && *cur == '+') ++cur;
+    auto result = std::from_chars(cur, end, out);
+    return result.ec == std::errc() ? result.ptr : nullptr;
+}
+
+const char* parsePoint(const char* cur, const char* end, Point& p) {
+    cur = parseFloat(cur, end, p.x);
+    if (!cur) return nullptr;
+    cur = skipBlanks(cur, end);
+    if (cur < end && *cur == ',') ++cur;
+    return parseFloat(cur, end, p.y);
+}
+
+const char* parseWord(const char* cur, const char* end, std::string& out) {
+    cur = skipBlanks(cur, end);
+    const char* first = cur;
+    while (cur < end && !isBlank(*cur) && *cur != '\n') ++cur;
+    if (cur == first) return nullptr;
+    out.assign(first, cur);
+    return cur;
+}
+
+// ========== PointReader ==========
+
+PointReader::PointReader(FILE* in, size_t bufferSize) : in(in), buf(bufferSize == 0 ? 1 : bufferSize) {}
+
+// Keeps the unread tail, then tops the buffer up from the file
+void PointReader::refill() {
+    size_t rest = len - pos;
+    if (rest == buf.size()) buf.resize(buf.size() * 2);   // A line longer than the buffer
+    std::memmove(buf.data(), buf.data() + pos, rest);
+    pos = 0;
+    len = rest;
+    size_t got = std::fread(buf.data() + len, 1, buf.size() - len, in);
+    len += got;
+    if (got == 0) eof = true;
+}
+
+// Next non-blank line as [first, last), without its newline
+bool PointReader::nextLine(const char*& first, const char*& last) {
+    while (true) {
+        const char* begin = buf.data() + pos;
+        const char* nl = static_cast<const char*>(std::memchr(begin, '\n', len - pos));
+        if (nl || (eof && pos < len)) {
+            first = begin;
+            last = nl ? nl : buf.data() + len;
+            pos = last - buf.data() + (nl ? 1 : 0);
+            if (skipBlanks(first, last) < last) return true;
+            continue;
+        }
+        if (eof) return false;
+        refill();
+    }
+}
+
+bool PointReader::readCount(long long& n) {
+    const char *first, *last;
+    return nextLine(first, last) && parseCount(first, last, n) != nullptr;
+}
+
+bool PointReader::next(Point& p) {
+    const char *first, *last;
+    return nextLine(first, last) && parsePoint(first, last, p) != nullptr;
+}
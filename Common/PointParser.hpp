@@ -0,0 +1,37 @@
+#pragma once
+#include "Geometry.hpp"
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <cstddef>
+
+// ======== In-place parsing ========
+// Each function parses from [cur, end), skipping leading blanks, and returns
+// the position just past what it consumed, or nullptr if the text does not parse.
+// Coordinates must be finite: "nan" and "inf" are rejected like any other bad text.
+
+const char* parseFloat(const char* cur, const char* end, float& out);
+const char* parseCount(const char* cur, const char* end, long long& out);
+const char* parsePoint(const char* cur, const char* end, Point& p);   // "x,y" or "x y"
+const char* parseWord(const char* cur, const char* end, std::string& out);   // Next run of non-blanks
+
+// ======== Buffered reader ========
+// Reads the "n" + one point per line format from a FILE* through one reusable
+// buffer, with no allocation per line.
+class PointReader {
+public:
+    explicit PointReader(FILE* in, size_t bufferSize = 1 << 20);
+
+    bool readCount(long long& n);             // The leading point count
+    bool next(Point& p);                      // False at end of input or on a malformed line
+
+private:
+    bool nextLine(const char*& first, const char*& last);
+    void refill();
+
+    FILE* in;
+    std::vector<char> buf;
+    size_t pos = 0;                           // Start of unread data
+    size_t len = 0;                           // End of valid data
+    bool eof = false;
+};
@@ -0,0 +1,56 @@
+#include "Prefilter.hpp"
+#include "Simd.hpp"
+#include <algorithm>
+
+// Hull of the eight extremes, counter-clockwise (ties collapse vertices)
+static std::vector<Point> octagon(const Point corners[8]) {
+    std::vector<Point> sorted(corners, corners + 8);
+    std::sort(sorted.begin(), sorted.end());
+    sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+    return hullOfSorted(sorted.data(), sorted.size());
+}
+
+void aklToussaintFilter(std::vector<Point>& P) {
+    size_t n = P.size();
+    if (n < 4) return;
+
+    // Extreme points in the eight compass directions
+    size_t ext[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+    for (size_t i = 1; i < n; ++i) {
+        const Point& p = P[i];
+        if (p.x < P[ext[0]].x) ext[0] = i;
+        if (p.x > P[ext[1]].x) ext[1] = i;
+        if (p.y < P[ext[2]].y) ext[2] = i;
+        if (p.y > P[ext[3]].y) ext[3] = i;
+        if (p.x + p.y < P[ext[4]].x + P[ext[4]].y) ext[4] = i;
+        if (p.x + p.y > P[ext[5]].x + P[ext[5]].y) ext[5] = i;
+        if (p.x - p.y < P[ext[6]].x - P[ext[6]].y) ext[6] = i;
+        if (p.x - p.y > P[ext[7]].x - P[ext[7]].y) ext[7] = i;
+    }
+
+    Point corners[8];
+    for (int j = 0; j < 8; ++j) corners[j] = P[ext[j]];
+    std::vector<Point> poly = octagon(corners);
+    int k = poly.size();
+    if (k < 3) return;
+
+    P.resize(keepOutsideConvex(poly.data(), k, P.data(), n));
+}
+
+std::vector<Point> aklToussaintFilter(const PointArray& P) {
+    size_t n = P.size();
+    if (n < 4) return P.snapshot();
+
+    // The extremes come from one pass over the contiguous x[] and y[] streams
+    size_t ext[8];
+    extremesSoA(P.x(), P.y(), n, ext);
+    Point corners[8];
+    for (int j = 0; j < 8; ++j) corners[j] = P[ext[j]];
+    std::vector<Point> poly = octagon(corners);
+    int k = poly.size();
+    if (k < 3) return P.snapshot();
+
+    std::vector<Point> survivors(n);
+    survivors.resize(keepOutsideConvexSoA(poly.data(), k, P.x(), P.y(), n, survivors.data()));
+    return survivors;
+}
@@ -0,0 +1,17 @@
+#pragma once
+#include "Geometry.hpp"
+#include "PointArray.hpp"
+#include <vector>
+#include <cstddef>
+
+// convexHull() prefilters its input from this many points on
+const size_t kPrefilterThreshold = 1024;
+
+// Akl-Toussaint heuristic: compacts P in place, dropping every point strictly
+// inside the octagon spanned by the extremes in x, y, x + y and x - y.
+// Such points can never be hull vertices, so the hull is unchanged.
+void aklToussaintFilter(std::vector<Point>& P);
+
+// Same filter over SoA storage, vectorized over the x[] and y[] streams;
+// returns the surviving points
+std::vector<Point> aklToussaintFilter(const PointArray& P);
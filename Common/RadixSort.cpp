@@ -0,0 +1,137 @@
+#include "RadixSort.hpp"
+#include "ParallelHull.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+
+// 64-bit key split into six 11-bit digits, least significant first
+static const int kDigitBits = 11;
+static const int kPasses = 6;
+static const size_t kBuckets = size_t(1) << kDigitBits;
+
+// Maps a float to an unsigned integer with the same ordering
+static inline uint32_t floatKey(float f) {
+    f += 0.0f;                                // -0.0 becomes 0.0
+    uint32_t u;
+    std::memcpy(&u, &f, sizeof(u));
+    return (u & 0x80000000u) ? ~u : (u | 0x80000000u);
+}
+
+static inline uint64_t pointKey(const Point& p) {
+    return (static_cast<uint64_t>(floatKey(p.x)) << 32) | floatKey(p.y);
+}
+
+static inline size_t digit(uint64_t key, int pass) {
+    return (key >> (pass * kDigitBits)) & (kBuckets - 1);
+}
+
+// A pass whose digit is the same for every point would only copy the data
+static bool trivialPass(const size_t* count, size_t n) {
+    for (size_t b = 0; b < kBuckets; ++b) {
+        if (count[b] != 0) return count[b] == n;
+    }
+    return true;
+}
+
+void radixSort(Point* P, size_t n) {
+    if (n < 2) return;
+
+    // One counting pass fills the histograms of all six digits
+    std::vector<size_t> count(kPasses * kBuckets, 0);
+    for (size_t i = 0; i < n; ++i) {
+        uint64_t key = pointKey(P[i]);
+        for (int pass = 0; pass < kPasses; ++pass) ++count[pass * kBuckets + digit(key, pass)];
+    }
+
+    std::vector<Point> buffer(n);
+    Point* src = P;
+    Point* dst = buffer.data();
+    for (int pass = 0; pass < kPasses; ++pass) {
+        size_t* c = &count[pass * kBuckets];
+        if (trivialPass(c, n)) continue;
+
+        size_t offset = 0;
+        for (size_t b = 0; b < kBuckets; ++b) {
+            size_t k = c[b];
+            c[b] = offset;
+            offset += k;
+        }
+        for (size_t i = 0; i < n; ++i) {
+            dst[c[digit(pointKey(src[i]), pass)]++] = src[i];
+        }
+        std::swap(src, dst);
+    }
+    if (src != P) std::copy(src, src + n, P);
+}
+
+void parallelRadixSort(std::vector<Point>& P, unsigned threads) {
+    size_t n = P.size();
+    unsigned T = threads == 0 ? hullThreads() : threads;
+    T = static_cast<unsigned>(std::min<size_t>(T, std::max<size_t>(1, n / kRadixSortThreshold)));
+    if (T <= 1) {
+        radixSort(P.data(), n);
+        return;
+    }
+
+    std::vector<Point> buffer(n);
+    Point* src = P.data();
+    Point* dst = buffer.data();
+    std::vector<size_t> bounds(T + 1);
+    for (unsigned t = 0; t <= T; ++t) bounds[t] = n * t / T;
+    std::vector<size_t> count(T * kBuckets);     // count[t * kBuckets + b]
+    std::vector<std::thread> workers;
+
+    for (int pass = 0; pass < kPasses; ++pass) {
+        // Per-thread histograms of this digit
+        std::fill(count.begin(), count.end(), 0);
+        workers.clear();
+        for (unsigned t = 0; t < T; ++t) {
+            workers.emplace_back([&, t] {
+                size_t* c = &count[t * kBuckets];
+                for (size_t i = bounds[t]; i < bounds[t + 1]; ++i) ++c[digit(pointKey(src[i]), pass)];
+            });
+        }
+        for (auto& w : workers) w.join();
+
+        // Bucket b of thread t starts after all smaller buckets and after bucket b of threads < t
+        std::vector<size_t> total(kBuckets, 0);
+        for (unsigned t = 0; t < T; ++t) {
+            for (size_t b = 0; b < kBuckets; ++b) total[b] += count[t * kBuckets + b];
+        }
+        if (trivialPass(total.data(), n)) continue;
+
+        size_t offset = 0;
+        for (size_t b = 0; b < kBuckets; ++b) {
+            for (unsigned t = 0; t < T; ++t) {
+                size_t k = count[t * kBuckets + b];
+                count[t * kBuckets + b] = offset;
+                offset += k;
+            }
+        }
+
+        // Stable scatter: each thread writes only into its own bucket ranges
+        workers.clear();
+        for (unsigned t = 0; t < T; ++t) {
+            workers.emplace_back([&, t] {
+                size_t* c = &count[t * kBuckets];
+                for (size_t i = bounds[t]; i < bounds[t + 1]; ++i) {
+                    dst[c[digit(pointKey(src[i]), pass)]++] = src[i];
+                }
+            });
+        }
+        for (auto& w : workers) w.join();
+        std::swap(src, dst);
+    }
+    if (src != P.data()) std::copy(src, src + n, P.data());
+}
+
+void sortPoints(Point* P, size_t n) {
+    if (n < kRadixSortThreshold) std::sort(P, P + n);
+    else radixSort(P, n);
+}
+
+void sortPoints(std::vector<Point>& P) {
+    if (P.size() >= kParallelHullThreshold && hullThreads() > 1) parallelRadixSort(P);
+    else sortPoints(P.data(), P.size());
+}
@@ -0,0 +1,17 @@
+#pragma once
+#include "Geometry.hpp"
+#include <vector>
+#include <cstddef>
+
+// Hull sorts switch from std::sort to radix sort from this many points on
+const size_t kRadixSortThreshold = 4096;
+
+// LSD radix sort on an order-preserving integer image of the (x, y) key.
+// Produces the same order as Point::operator< (-0.0 and 0.0 tie as well).
+void radixSort(Point* P, size_t n);
+
+// Radix sort with every pass split across threads (per-thread histograms)
+void parallelRadixSort(std::vector<Point>& P, unsigned threads = 0);
+
+void sortPoints(Point* P, size_t n);          // std::sort or radixSort, by size
+void sortPoints(std::vector<Point>& P);       // Same, plus parallelRadixSort for very large inputs
@@ -0,0 +1,105 @@
+#include "Rcu.hpp"
+#include <utility>
+
+// Records this thread holds, released for reuse when the thread exits
+struct EpochThreadRecords {
+    std::vector<std::pair<const EpochDomain*, EpochDomain::Record*>> entries;
+
+    ~EpochThreadRecords() {
+        for (auto& entry : entries) {
+            entry.second->local.store(0, std::memory_order_release);
+            entry.second->inUse.store(false, std::memory_order_release);
+        }
+    }
+};
+
+static thread_local EpochThreadRecords threadRecords;
+
+EpochDomain::~EpochDomain() {
+    Record* rec = records.load();
+    while (rec) {
+        Record* next = rec->next;
+        delete rec;
+        rec = next;
+    }
+}
+
+EpochDomain::Record* EpochDomain::threadRecord() {
+    for (auto& [domain, rec] : threadRecords.entries) {
+        if (domain == this) return rec;
+    }
+
+    // Take over a record left by an exited thread before growing the list
+    Record* rec = nullptr;
+    for (Record* r = records.load(std::memory_order_acquire); r; r = r->next) {
+        bool idle = false;
+        if (r->inUse.compare_exchange_strong(idle, true)) {
+            rec = r;
+            break;
+        }
+    }
+    if (!rec) {
+        rec = new Record;
+        rec->next = records.load(std::memory_order_relaxed);
+        while (!records.compare_exchange_weak(rec->next, rec)) {}
+    }
+    threadRecords.entries.emplace_back(this, rec);
+    return rec;
+}
+
+// ========== Read side ==========
+
+void EpochDomain::enter() {
+    Record* rec = threadRecord();
+    if (rec->depth++ > 0) return;
+    // Sequentially consistent so the announcement is visible before any
+    // shared pointer is loaded, and to every writer scanning the records
+    rec->local.store(epoch.load(std::memory_order_relaxed), std::memory_order_seq_cst);
+}
+
+void EpochDomain::exit() {
+    Record* rec = threadRecord();
+    if (--rec->depth > 0) return;
+    rec->local.store(0, std::memory_order_release);
+}
+
+// ========== Write side ==========
+
+// The epoch moves on only once every active reader has announced it
+bool EpochDomain::tryAdvance() {
+    uint64_t e = epoch.load(std::memory_order_seq_cst);
+    for (Record* r = records.load(std::memory_order_acquire); r; r = r->next) {
+        uint64_t local = r->local.load(std::memory_order_seq_cst);
+        if (local != 0 && local != e) return false;
+    }
+    return epoch.compare_exchange_strong(e, e + 1);
+}
+
+// ========== RetireList ==========
+
+RetireList::~RetireList() {
+    for (const Retired& r : retired) r.deleter(r.p);
+}
+
+void RetireList::collect() {
+    uint64_t e = domain.epoch.load(std::memory_order_acquire);
+    size_t kept = 0;
+    for (const Retired& r : retired) {
+        if (r.epoch + 2 <= e) r.deleter(r.p);
+        else retired[kept++] = r;
+    }
+    retired.resize(kept);
+}
+
+void RetireList::retire(void* p, void (*deleter)(void*)) {
+    std::lock_guard<std::mutex> lock(mutex);
+    retired.push_back({p, deleter, domain.epoch.load(std::memory_order_seq_cst)});
+    // Two advances are enough to free everything retired before this call
+    if (domain.tryAdvance()) domain.tryAdvance();
+    collect();
+}
+
+size_t RetireList::pending() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return retired.size();
+}
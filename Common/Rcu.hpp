@@ -0,0 +1,89 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+// ======== Epoch-based reclamation ========
+// Read-copy-update support: readers bracket their accesses with an EpochGuard
+// and never block; writers publish a new version with an atomic exchange and
+// retire the old one on a RetireList, which frees it only once every reader
+// that could still hold it has left its critical section.
+//
+// The global epoch advances when every active reader has observed it. An
+// object retired in epoch e is unreachable for readers entering later, so it
+// is freed once the epoch reaches e + 2.
+class EpochDomain {
+public:
+    EpochDomain() = default;
+    ~EpochDomain();                           // Outlives every RetireList on it
+
+    EpochDomain(const EpochDomain&) = delete;
+    EpochDomain& operator=(const EpochDomain&) = delete;
+
+    void enter();                             // Begin a read-side critical section (nestable)
+    void exit();
+
+private:
+    struct Record {                           // One per thread that has read; reused after it exits
+        std::atomic<uint64_t> local{0};       // Epoch announced by the reader, 0 when quiescent
+        std::atomic<bool> inUse{true};
+        unsigned depth = 0;                   // Nesting, touched by the owning thread only
+        Record* next = nullptr;
+    };
+    Record* threadRecord();
+    bool tryAdvance();                        // Lock-free; any writer may call it
+
+    std::atomic<uint64_t> epoch{1};
+    std::atomic<Record*> records{nullptr};
+
+    friend struct EpochThreadRecords;
+    friend class RetireList;
+};
+
+// ======== Retirement ========
+// Objects retired on one list wait for the domain's epoch to move on. Writers
+// that keep separate lists (one per graph) share no lock: advancing the epoch
+// only reads the reader records and swings one atomic.
+class RetireList {
+public:
+    explicit RetireList(EpochDomain& domain) : domain(domain) {}
+    ~RetireList();                            // Frees everything still retired
+
+    RetireList(const RetireList&) = delete;
+    RetireList& operator=(const RetireList&) = delete;
+
+    template <typename T>
+    void retire(const T* p) {
+        retire(const_cast<T*>(p), [](void* q) { delete static_cast<T*>(q); });
+    }
+    void retire(void* p, void (*deleter)(void*));
+
+    size_t pending() const;                   // Retired objects not yet freed
+
+private:
+    struct Retired {
+        void* p;
+        void (*deleter)(void*);
+        uint64_t epoch;
+    };
+
+    void collect();                           // Frees what no reader can hold; caller holds mutex
+
+    EpochDomain& domain;
+    mutable std::mutex mutex;
+    std::vector<Retired> retired;
+};
+
+// RAII read-side critical section
+class EpochGuard {
+public:
+    explicit EpochGuard(EpochDomain& d) : domain(d) { domain.enter(); }
+    ~EpochGuard() { domain.exit(); }
+
+    EpochGuard(const EpochGuard&) = delete;
+    EpochGuard& operator=(const EpochGuard&) = delete;
+
+private:
+    EpochDomain& domain;
+};
@@ -0,0 +1,434 @@
+#include "Simd.hpp"
+#include <algorithm>
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define HULL_X86 1
+#endif
+
+// Convex polygon edges, evaluated in double so near-boundary points are not misjudged
+struct Edges {
+    int k;
+    double ox[8], oy[8], dx[8], dy[8];
+
+    Edges(const Point* poly, int count) : k(count < 8 ? count : 8) {
+        for (int j = 0; j < k; ++j) {
+            const Point& a = poly[j];
+            const Point& b = poly[(j + 1) % k];
+            ox[j] = a.x;
+            oy[j] = a.y;
+            dx[j] = static_cast<double>(b.x) - a.x;
+            dy[j] = static_cast<double>(b.y) - a.y;
+        }
+    }
+
+    bool inside(const Point& p) const {
+        bool in = true;
+        for (int j = 0; j < k; ++j) {
+            in &= dx[j] * (p.y - oy[j]) - dy[j] * (p.x - ox[j]) > 0;
+        }
+        return in;
+    }
+};
+
+// ========== Scalar ==========
+
+static void orientBatchScalar(const Point& O, const Point& A, const Point* P, size_t n, double* out) {
+    for (size_t i = 0; i < n; ++i) out[i] = cross(O, A, P[i]);
+}
+
+static double shoelaceTail(const Point* poly, size_t i, size_t n) {
+    double sum = 0.0;
+    for (; i < n; ++i) {
+        const Point& p1 = poly[i];
+        const Point& p2 = poly[i + 1 < n ? i + 1 : 0];
+        sum += static_cast<double>(p1.x) * p2.y - static_cast<double>(p2.x) * p1.y;
+    }
+    return sum;
+}
+
+static double shoelaceSumScalar(const Point* poly, size_t n) {
+    return shoelaceTail(poly, 0, n);
+}
+
+static size_t keepOutsideFrom(const Edges& e, Point* P, size_t i, size_t kept, size_t n) {
+    for (; i < n; ++i) {
+        Point p = P[i];
+        P[kept] = p;
+        kept += !e.inside(p);
+    }
+    return kept;
+}
+
+static size_t keepOutsideConvexScalar(const Point* poly, int k, Point* P, size_t n) {
+    return keepOutsideFrom(Edges(poly, k), P, 0, 0, n);
+}
+
+// Direction keys, all maximized: -x, x, -y, y, -(x+y), x+y, -(x-y), x-y
+static inline void extremeKeys(float x, float y, float key[8]) {
+    float s = x + y, d = x - y;
+    key[0] = -x; key[1] = x;
+    key[2] = -y; key[3] = y;
+    key[4] = -s; key[5] = s;
+    key[6] = -d; key[7] = d;
+}
+
+// Folds points [i, n) into best/ext (best[k] is the key of point ext[k])
+static void extremesFrom(const float* x, const float* y, size_t i, size_t n, float best[8], size_t ext[8]) {
+    float key[8];
+    for (; i < n; ++i) {
+        extremeKeys(x[i], y[i], key);
+        for (int k = 0; k < 8; ++k) {
+            if (key[k] > best[k]) {
+                best[k] = key[k];
+                ext[k] = i;
+            }
+        }
+    }
+}
+
+static void extremesSoAScalar(const float* x, const float* y, size_t n, size_t ext[8]) {
+    float best[8];
+    extremeKeys(x[0], y[0], best);
+    std::fill(ext, ext + 8, 0);
+    extremesFrom(x, y, 1, n, best, ext);
+}
+
+// Merges one lane's candidate into the running extremes, preferring the lower index on ties
+static inline void mergeExtreme(float value, size_t index, float& best, size_t& ext) {
+    if (value > best || (value == best && index < ext)) {
+        best = value;
+        ext = index;
+    }
+}
+
+static size_t keepOutsideSoAFrom(const Edges& e, const float* x, const float* y,
+                                 size_t i, size_t n, Point* out, size_t kept) {
+    for (; i < n; ++i) {
+        Point p = {x[i], y[i]};
+        out[kept] = p;
+        kept += !e.inside(p);
+    }
+    return kept;
+}
+
+static size_t keepOutsideConvexSoAScalar(const Point* poly, int k, const float* x, const float* y,
+                                         size_t n, Point* out) {
+    return keepOutsideSoAFrom(Edges(poly, k), x, y, 0, n, out, 0);
+}
+
+// SIMD extremes track lane indices as int32, so they scan in blocks of this many points
+static const size_t kExtremesBlock = size_t(1) << 30;
+
+#ifdef HULL_X86
+
+// ========== SSE2 ==========
+
+// The SIMD versions widen to double and follow cross() operation for operation
+
+__attribute__((target("sse2")))
+static void orientBatchSse2(const Point& O, const Point& A, const Point* P, size_t n, double* out) {
+    const __m128d ox = _mm_set1_pd(O.x), oy = _mm_set1_pd(O.y);
+    const __m128d ax = _mm_set1_pd(static_cast<double>(A.x) - O.x);
+    const __m128d ay = _mm_set1_pd(static_cast<double>(A.y) - O.y);
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2) {
+        __m128 f = _mm_loadu_ps(&P[i].x);                          // x0 y0 x1 y1
+        __m128d p0 = _mm_cvtps_pd(f), p1 = _mm_cvtps_pd(_mm_movehl_ps(f, f));
+        __m128d xs = _mm_unpacklo_pd(p0, p1), ys = _mm_unpackhi_pd(p0, p1);
+        __m128d r = _mm_sub_pd(_mm_mul_pd(ax, _mm_sub_pd(ys, oy)), _mm_mul_pd(ay, _mm_sub_pd(xs, ox)));
+        _mm_storeu_pd(out + i, r);
+    }
+    orientBatchScalar(O, A, P + i, n - i, out + i);
+}
+
+__attribute__((target("sse2")))
+static double shoelaceSumSse2(const Point* poly, size_t n) {
+    __m128d acc = _mm_setzero_pd();
+    size_t i = 0;
+    for (; i + 3 <= n; i += 2) {
+        __m128 a = _mm_loadu_ps(&poly[i].x);                        // x0 y0 x1 y1
+        __m128 b = _mm_loadu_ps(&poly[i + 1].x);                    // x1 y1 x2 y2
+        b = _mm_shuffle_ps(b, b, _MM_SHUFFLE(2, 3, 0, 1));          // y1 x1 y2 x2
+        __m128d lo = _mm_mul_pd(_mm_cvtps_pd(a), _mm_cvtps_pd(b));  // x0*y1, y0*x1
+        __m128d hi = _mm_mul_pd(_mm_cvtps_pd(_mm_movehl_ps(a, a)), _mm_cvtps_pd(_mm_movehl_ps(b, b)));
+        acc = _mm_add_pd(acc, _mm_sub_pd(_mm_unpacklo_pd(lo, hi), _mm_unpackhi_pd(lo, hi)));
+    }
+    double lanes[2];
+    _mm_storeu_pd(lanes, acc);
+    return lanes[0] + lanes[1] + shoelaceTail(poly, i, n);
+}
+
+__attribute__((target("sse2")))
+static size_t keepOutsideConvexSse2(const Point* poly, int k, Point* P, size_t n) {
+    Edges e(poly, k);
+    size_t kept = 0, i = 0;
+    for (; i + 2 <= n; i += 2) {
+        Point q[2] = {P[i], P[i + 1]};
+        __m128 f = _mm_loadu_ps(&q[0].x);
+        __m128d p0 = _mm_cvtps_pd(f), p1 = _mm_cvtps_pd(_mm_movehl_ps(f, f));
+        __m128d xs = _mm_unpacklo_pd(p0, p1), ys = _mm_unpackhi_pd(p0, p1);
+        __m128d in = _mm_castsi128_pd(_mm_set1_epi32(-1));
+        for (int j = 0; j < e.k; ++j) {
+            __m128d c = _mm_sub_pd(_mm_mul_pd(_mm_set1_pd(e.dx[j]), _mm_sub_pd(ys, _mm_set1_pd(e.oy[j]))),
+                                   _mm_mul_pd(_mm_set1_pd(e.dy[j]), _mm_sub_pd(xs, _mm_set1_pd(e.ox[j]))));
+            in = _mm_and_pd(in, _mm_cmpgt_pd(c, _mm_setzero_pd()));
+        }
+        int mask = _mm_movemask_pd(in);
+        for (int l = 0; l < 2; ++l) {
+            P[kept] = q[l];
+            kept += !((mask >> l) & 1);
+        }
+    }
+    return keepOutsideFrom(e, P, i, kept, n);
+}
+
+__attribute__((target("sse2")))
+static inline __m128 blendSse2(__m128 a, __m128 b, __m128 mask) {
+    return _mm_or_ps(_mm_andnot_ps(mask, a), _mm_and_ps(mask, b));
+}
+
+__attribute__((target("sse2")))
+static void extremesSoASse2(const float* x, const float* y, size_t n, size_t ext[8]) {
+    float best[8];
+    extremeKeys(x[0], y[0], best);
+    std::fill(ext, ext + 8, 0);
+    const __m128 sign = _mm_set1_ps(-0.0f);
+    size_t i = 0;
+    while (i + 4 <= n) {
+        size_t base = i, stop = base + std::min((n - base) / 4 * 4, kExtremesBlock);
+        __m128 bv[8], bi[8];                                      // Lane best key, lane index (as int bits)
+        for (int k = 0; k < 8; ++k) {
+            bv[k] = _mm_set1_ps(-__builtin_inff());
+            bi[k] = _mm_setzero_ps();
+        }
+        __m128i idx = _mm_setr_epi32(0, 1, 2, 3);
+        for (; i < stop; i += 4) {
+            __m128 xs = _mm_loadu_ps(x + i), ys = _mm_loadu_ps(y + i);
+            __m128 s = _mm_add_ps(xs, ys), d = _mm_sub_ps(xs, ys);
+            __m128 key[8] = {_mm_xor_ps(xs, sign), xs, _mm_xor_ps(ys, sign), ys,
+                             _mm_xor_ps(s, sign), s, _mm_xor_ps(d, sign), d};
+            for (int k = 0; k < 8; ++k) {
+                __m128 better = _mm_cmpgt_ps(key[k], bv[k]);
+                bv[k] = blendSse2(bv[k], key[k], better);
+                bi[k] = blendSse2(bi[k], _mm_castsi128_ps(idx), better);
+            }
+            idx = _mm_add_epi32(idx, _mm_set1_epi32(4));
+        }
+        for (int k = 0; k < 8; ++k) {
+            float v[4];
+            int32_t at[4];
+            _mm_storeu_ps(v, bv[k]);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(at), _mm_castps_si128(bi[k]));
+            for (int l = 0; l < 4; ++l) mergeExtreme(v[l], base + at[l], best[k], ext[k]);
+        }
+    }
+    extremesFrom(x, y, i, n, best, ext);
+}
+
+__attribute__((target("sse2")))
+static size_t keepOutsideConvexSoASse2(const Point* poly, int k, const float* x, const float* y,
+                                       size_t n, Point* out) {
+    Edges e(poly, k);
+    size_t kept = 0, i = 0;
+    for (; i + 2 <= n; i += 2) {
+        __m128d xs = _mm_setr_pd(x[i], x[i + 1]), ys = _mm_setr_pd(y[i], y[i + 1]);
+        __m128d in = _mm_castsi128_pd(_mm_set1_epi32(-1));
+        for (int j = 0; j < e.k; ++j) {
+            __m128d c = _mm_sub_pd(_mm_mul_pd(_mm_set1_pd(e.dx[j]), _mm_sub_pd(ys, _mm_set1_pd(e.oy[j]))),
+                                   _mm_mul_pd(_mm_set1_pd(e.dy[j]), _mm_sub_pd(xs, _mm_set1_pd(e.ox[j]))));
+            in = _mm_and_pd(in, _mm_cmpgt_pd(c, _mm_setzero_pd()));
+        }
+        int outside = ~_mm_movemask_pd(in) & 0x3;
+        for (; outside; outside &= outside - 1) {
+            int l = __builtin_ctz(outside);
+            out[kept++] = {x[i + l], y[i + l]};
+        }
+    }
+    return keepOutsideSoAFrom(e, x, y, i, n, out, kept);
+}
+
+// ========== AVX2 ==========
+
+__attribute__((target("avx2")))
+static void orientBatchAvx2(const Point& O, const Point& A, const Point* P, size_t n, double* out) {
+    const __m256d ox = _mm256_set1_pd(O.x), oy = _mm256_set1_pd(O.y);
+    const __m256d ax = _mm256_set1_pd(static_cast<double>(A.x) - O.x);
+    const __m256d ay = _mm256_set1_pd(static_cast<double>(A.y) - O.y);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128 lo = _mm_loadu_ps(&P[i].x), hi = _mm_loadu_ps(&P[i + 2].x);
+        __m256d xs = _mm256_cvtps_pd(_mm_shuffle_ps(lo, hi, _MM_SHUFFLE(2, 0, 2, 0)));
+        __m256d ys = _mm256_cvtps_pd(_mm_shuffle_ps(lo, hi, _MM_SHUFFLE(3, 1, 3, 1)));
+        __m256d r = _mm256_sub_pd(_mm256_mul_pd(ax, _mm256_sub_pd(ys, oy)),
+                                  _mm256_mul_pd(ay, _mm256_sub_pd(xs, ox)));
+        _mm256_storeu_pd(out + i, r);
+    }
+    orientBatchScalar(O, A, P + i, n - i, out + i);
+}
+
+__attribute__((target("avx2")))
+static double shoelaceSumAvx2(const Point* poly, size_t n) {
+    __m256d acc = _mm256_setzero_pd();
+    size_t i = 0;
+    for (; i + 5 <= n; i += 4) {
+        __m256 a = _mm256_loadu_ps(&poly[i].x);                     // x0 y0 x1 y1 | x2 y2 x3 y3
+        __m256 b = _mm256_loadu_ps(&poly[i + 1].x);                 // x1 y1 x2 y2 | x3 y3 x4 y4
+        b = _mm256_permute_ps(b, _MM_SHUFFLE(2, 3, 0, 1));          // y1 x1 y2 x2 | y3 x3 y4 x4
+        __m256d lo = _mm256_mul_pd(_mm256_cvtps_pd(_mm256_castps256_ps128(a)),
+                                   _mm256_cvtps_pd(_mm256_castps256_ps128(b)));
+        __m256d hi = _mm256_mul_pd(_mm256_cvtps_pd(_mm256_extractf128_ps(a, 1)),
+                                   _mm256_cvtps_pd(_mm256_extractf128_ps(b, 1)));
+        acc = _mm256_add_pd(acc, _mm256_hsub_pd(lo, hi));           // One shoelace term per lane
+    }
+    double lanes[4];
+    _mm256_storeu_pd(lanes, acc);
+    return (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]) + shoelaceTail(poly, i, n);
+}
+
+__attribute__((target("avx2")))
+static size_t keepOutsideConvexAvx2(const Point* poly, int k, Point* P, size_t n) {
+    Edges e(poly, k);
+    size_t kept = 0, i = 0;
+    for (; i + 4 <= n; i += 4) {
+        Point q[4] = {P[i], P[i + 1], P[i + 2], P[i + 3]};
+        __m128 lo = _mm_loadu_ps(&q[0].x), hi = _mm_loadu_ps(&q[2].x);
+        __m256d xs = _mm256_cvtps_pd(_mm_shuffle_ps(lo, hi, _MM_SHUFFLE(2, 0, 2, 0)));
+        __m256d ys = _mm256_cvtps_pd(_mm_shuffle_ps(lo, hi, _MM_SHUFFLE(3, 1, 3, 1)));
+        __m256d in = _mm256_castsi256_pd(_mm256_set1_epi32(-1));
+        for (int j = 0; j < e.k; ++j) {
+            __m256d c = _mm256_sub_pd(
+                _mm256_mul_pd(_mm256_set1_pd(e.dx[j]), _mm256_sub_pd(ys, _mm256_set1_pd(e.oy[j]))),
+                _mm256_mul_pd(_mm256_set1_pd(e.dy[j]), _mm256_sub_pd(xs, _mm256_set1_pd(e.ox[j]))));
+            in = _mm256_and_pd(in, _mm256_cmp_pd(c, _mm256_setzero_pd(), _CMP_GT_OQ));
+        }
+        int mask = _mm256_movemask_pd(in);
+        for (int l = 0; l < 4; ++l) {
+            P[kept] = q[l];
+            kept += !((mask >> l) & 1);
+        }
+    }
+    return keepOutsideFrom(e, P, i, kept, n);
+}
+
+__attribute__((target("avx2")))
+static void extremesSoAAvx2(const float* x, const float* y, size_t n, size_t ext[8]) {
+    float best[8];
+    extremeKeys(x[0], y[0], best);
+    std::fill(ext, ext + 8, 0);
+    const __m256 sign = _mm256_set1_ps(-0.0f);
+    size_t i = 0;
+    while (i + 8 <= n) {
+        size_t base = i, stop = base + std::min((n - base) / 8 * 8, kExtremesBlock);
+        __m256 bv[8];                                             // Lane best key
+        __m256i bi[8];                                            // Lane index, relative to base
+        for (int k = 0; k < 8; ++k) {
+            bv[k] = _mm256_set1_ps(-__builtin_inff());
+            bi[k] = _mm256_setzero_si256();
+        }
+        __m256i idx = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+        for (; i < stop; i += 8) {
+            __m256 xs = _mm256_loadu_ps(x + i), ys = _mm256_loadu_ps(y + i);
+            __m256 s = _mm256_add_ps(xs, ys), d = _mm256_sub_ps(xs, ys);
+            __m256 key[8] = {_mm256_xor_ps(xs, sign), xs, _mm256_xor_ps(ys, sign), ys,
+                             _mm256_xor_ps(s, sign), s, _mm256_xor_ps(d, sign), d};
+            for (int k = 0; k < 8; ++k) {
+                __m256 better = _mm256_cmp_ps(key[k], bv[k], _CMP_GT_OQ);
+                bv[k] = _mm256_blendv_ps(bv[k], key[k], better);
+                bi[k] = _mm256_blendv_epi8(bi[k], idx, _mm256_castps_si256(better));
+            }
+            idx = _mm256_add_epi32(idx, _mm256_set1_epi32(8));
+        }
+        for (int k = 0; k < 8; ++k) {
+            float v[8];
+            int32_t at[8];
+            _mm256_storeu_ps(v, bv[k]);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(at), bi[k]);
+            for (int l = 0; l < 8; ++l) mergeExtreme(v[l], base + at[l], best[k], ext[k]);
+        }
+    }
+    extremesFrom(x, y, i, n, best, ext);
+}
+
+__attribute__((target("avx2")))
+static size_t keepOutsideConvexSoAAvx2(const Point* poly, int k, const float* x, const float* y,
+                                       size_t n, Point* out) {
+    Edges e(poly, k);
+    size_t kept = 0, i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256d xs = _mm256_cvtps_pd(_mm_loadu_ps(x + i));
+        __m256d ys = _mm256_cvtps_pd(_mm_loadu_ps(y + i));
+        __m256d in = _mm256_castsi256_pd(_mm256_set1_epi32(-1));
+        for (int j = 0; j < e.k; ++j) {
+            __m256d c = _mm256_sub_pd(
+                _mm256_mul_pd(_mm256_set1_pd(e.dx[j]), _mm256_sub_pd(ys, _mm256_set1_pd(e.oy[j]))),
+                _mm256_mul_pd(_mm256_set1_pd(e.dy[j]), _mm256_sub_pd(xs, _mm256_set1_pd(e.ox[j]))));
+            in = _mm256_and_pd(in, _mm256_cmp_pd(c, _mm256_setzero_pd(), _CMP_GT_OQ));
+        }
+        int outside = ~_mm256_movemask_pd(in) & 0xF;
+        for (; outside; outside &= outside - 1) {
+            int l = __builtin_ctz(outside);
+            out[kept++] = {x[i + l], y[i + l]};
+        }
+    }
+    return keepOutsideSoAFrom(e, x, y, i, n, out, kept);
+}
+
+#endif
+
+// ========== Dispatch ==========
+
+struct Kernels {
+    const char* name;
+    void (*orient)(const Point&, const Point&, const Point*, size_t, double*);
+    double (*shoelace)(const Point*, size_t);
+    size_t (*keepOutside)(const Point*, int, Point*, size_t);
+    void (*extremes)(const float*, const float*, size_t, size_t*);
+    size_t (*keepOutsideSoA)(const Point*, int, const float*, const float*, size_t, Point*);
+};
+
+static Kernels selectKernels() {
+#ifdef HULL_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        return {"avx2", orientBatchAvx2, shoelaceSumAvx2, keepOutsideConvexAvx2,
+                extremesSoAAvx2, keepOutsideConvexSoAAvx2};
+    }
+    if (__builtin_cpu_supports("sse2")) {
+        return {"sse2", orientBatchSse2, shoelaceSumSse2, keepOutsideConvexSse2,
+                extremesSoASse2, keepOutsideConvexSoASse2};
+    }
+#endif
+    return {"scalar", orientBatchScalar, shoelaceSumScalar, keepOutsideConvexScalar,
+            extremesSoAScalar, keepOutsideConvexSoAScalar};
+}
+
+static const Kernels& kernels() {
+    static const Kernels k = selectKernels();
+    return k;
+}
+
+const char* simdBackend() {
+    return kernels().name;
+}
+
+void orientBatch(const Point& O, const Point& A, const Point* P, size_t n, double* out) {
+    kernels().orient(O, A, P, n, out);
+}
+
+double shoelaceSum(const Point* poly, size_t n) {
+    return kernels().shoelace(poly, n);
+}
+
+size_t keepOutsideConvex(const Point* poly, int k, Point* P, size_t n) {
+    return kernels().keepOutside(poly, k, P, n);
+}
+
+void extremesSoA(const float* x, const float* y, size_t n, size_t ext[8]) {
+    kernels().extremes(x, y, n, ext);
+}
+
+size_t keepOutsideConvexSoA(const Point* poly, int k, const float* x, const float* y, size_t n, Point* out) {
+    return kernels().keepOutsideSoA(poly, k, x, y, n, out);
+}
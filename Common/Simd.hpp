@@ -0,0 +1,28 @@
+#pragma once
+#include "Geometry.hpp"
+#include <cstddef>
+
+// Batched geometry kernels. Each one has AVX2, SSE2 and scalar versions;
+// the fastest one the CPU supports is picked at runtime on first use.
+
+const char* simdBackend();                                   // "avx2", "sse2" or "scalar"
+
+// out[i] = cross(O, A, P[i]) for i in [0, n), bit for bit
+void orientBatch(const Point& O, const Point& A, const Point* P, size_t n, double* out);
+
+// Shoelace sum of the closed polygon (twice its signed area), accumulated in double
+double shoelaceSum(const Point* poly, size_t n);
+
+// Compacts P[0, n) in place, keeping only points not strictly inside the
+// counter-clockwise convex polygon poly[0, k), k <= 8. Returns the new count.
+size_t keepOutsideConvex(const Point* poly, int k, Point* P, size_t n);
+
+// ---- Structure-of-arrays inputs: coordinates as separate x[] and y[] streams ----
+
+// Indices of the extreme points in the directions -x, +x, -y, +y, -(x+y), +(x+y),
+// -(x-y), +(x-y), first occurrence on ties. The first four give the bounding box. n > 0.
+void extremesSoA(const float* x, const float* y, size_t n, size_t ext[8]);
+
+// Writes the points (x[i], y[i]), i in [0, n), that are not strictly inside the
+// counter-clockwise convex polygon poly[0, k), k <= 8, to out. Returns their count.
+size_t keepOutsideConvexSoA(const Point* poly, int k, const float* x, const float* y, size_t n, Point* out);
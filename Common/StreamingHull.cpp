@@ -0,0 +1,23 @@
+#include "StreamingHull.hpp"
+
+StreamingHull::StreamingHull(size_t chunkSize) : chunkSize(chunkSize == 0 ? 1 : chunkSize) {
+    buffer.reserve(this->chunkSize);
+}
+
+void StreamingHull::add(const Point& p) {
+    buffer.push_back(p);
+    ++seen;
+    if (buffer.size() - hullSize >= chunkSize) flush();
+}
+
+void StreamingHull::flush() {
+    if (buffer.size() == hullSize) return;
+    buffer = convexHull(std::move(buffer));
+    hullSize = buffer.size();
+    buffer.reserve(hullSize + chunkSize);
+}
+
+std::vector<Point> StreamingHull::hull() {
+    flush();
+    return buffer;
+}
@@ -0,0 +1,24 @@
+#pragma once
+#include "Geometry.hpp"
+#include <vector>
+#include <cstddef>
+
+// Hull of a point stream in O(h + chunk) memory. Points are buffered behind
+// the current hull vertices; when a chunk is full, the buffer is replaced by
+// its hull, so nothing but hull candidates survives between chunks.
+class StreamingHull {
+public:
+    explicit StreamingHull(size_t chunkSize = 1 << 20);
+
+    void add(const Point& p);
+    std::vector<Point> hull();                // Folds in the pending chunk
+    size_t count() const { return seen; }     // Points streamed so far
+
+private:
+    void flush();
+
+    size_t chunkSize;
+    std::vector<Point> buffer;                // Hull vertices, then pending points
+    size_t hullSize = 0;
+    size_t seen = 0;
+};
@@ -0,0 +1,41 @@
+#include "TaskPool.hpp"
+#include <utility>
+
+TaskPool::TaskPool(unsigned threads) {
+    if (threads == 0) threads = std::thread::hardware_concurrency();
+    threadCount = threads == 0 ? 1 : threads;
+}
+
+TaskPool::~TaskPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    ready.notify_all();
+    for (auto& w : workers) w.join();
+}
+
+void TaskPool::submit(std::function<void()> task) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (workers.empty()) {
+            for (unsigned t = 0; t < threadCount; ++t) workers.emplace_back([this] { work(); });
+        }
+        tasks.push_back(std::move(task));
+    }
+    ready.notify_one();
+}
+
+void TaskPool::work() {
+    while (true) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            ready.wait(lock, [this] { return stopping || !tasks.empty(); });
+            if (tasks.empty()) return;
+            task = std::move(tasks.front());
+            tasks.pop_front();
+        }
+        task();
+    }
+}
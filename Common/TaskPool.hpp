@@ -0,0 +1,32 @@
+#pragma once
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// ======== Task pool ========
+// A fixed set of worker threads running submitted tasks in FIFO order.
+// Workers start lazily on the first submit(), so a pool declared at file
+// scope costs nothing until it is used.
+class TaskPool {
+public:
+    explicit TaskPool(unsigned threads = 0);  // 0: one per hardware thread
+    ~TaskPool();                              // Runs what is queued, then joins
+
+    TaskPool(const TaskPool&) = delete;
+    TaskPool& operator=(const TaskPool&) = delete;
+
+    void submit(std::function<void()> task);
+
+private:
+    void work();
+
+    unsigned threadCount;
+    std::mutex mutex;
+    std::condition_variable ready;
+    std::deque<std::function<void()>> tasks;
+    std::vector<std::thread> workers;
+    bool stopping = false;
+};
@@ -0,0 +1,76 @@
+#include "WireProtocol.hpp"
+#include <cstring>
+
+static inline uint64_t getLE(const char* src, int bytes) {
+    uint64_t v = 0;
+    for (int i = 0; i < bytes; ++i) v |= uint64_t(static_cast<unsigned char>(src[i])) << (8 * i);
+    return v;
+}
+
+bool readWireHeader(const char* data, size_t size, WireHeader& h) {
+    if (size < kWireHeaderSize) return false;
+    h.length = static_cast<uint32_t>(getLE(data, 4));
+    h.opcode = static_cast<uint16_t>(getLE(data + 4, 2));
+    return true;
+}
+
+// ========== WireFrame ==========
+
+WireFrame::WireFrame(uint16_t opcode) {
+    buf.reserve(64);
+    putLE(0, 4);
+    putLE(opcode, 2);
+    putLE(0, 2);
+}
+
+void WireFrame::putLE(uint64_t v, int bytes) {
+    for (int i = 0; i < bytes; ++i) buf.push_back(static_cast<char>(v >> (8 * i)));
+}
+
+WireFrame& WireFrame::u8(uint8_t v) {
+    putLE(v, 1);
+    return *this;
+}
+
+WireFrame& WireFrame::u64(uint64_t v) {
+    putLE(v, 8);
+    return *this;
+}
+
+WireFrame& WireFrame::f32(float v) {
+    uint32_t u;
+    std::memcpy(&u, &v, 4);
+    putLE(u, 4);
+    return *this;
+}
+
+WireFrame& WireFrame::f64(double v) {
+    uint64_t u;
+    std::memcpy(&u, &v, 8);
+    putLE(u, 8);
+    return *this;
+}
+
+WireFrame& WireFrame::point(const Point& p) {
+    return f32(p.x).f32(p.y);
+}
+
+WireFrame& WireFrame::points(const std::vector<Point>& P) {
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    buf.append(reinterpret_cast<const char*>(P.data()), P.size() * sizeof(Point));
+#else
+    for (const Point& p : P) point(p);
+#endif
+    return *this;
+}
+
+WireFrame& WireFrame::text(const std::string& s) {
+    buf += s;
+    return *this;
+}
+
+const std::string& WireFrame::data() {
+    uint64_t length = buf.size() - kWireHeaderSize;
+    for (int i = 0; i < 4; ++i) buf[i] = static_cast<char>(length >> (8 * i));
+    return buf;
+}
@@ -0,0 +1,57 @@
+#pragma once
+#include "Geometry.hpp"
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// ======== Binary wire protocol ========
+// Once a client sends the text command "Binary", both directions switch to
+// frames: an 8-byte little-endian header (u32 payload length, u16 opcode,
+// u16 reserved) followed by the payload. Points are interleaved f32 pairs.
+// Every request gets exactly one reply frame with the request's opcode, or
+// WIRE_ERROR carrying a text message.
+
+enum WireOpcode : uint16_t {                  // Request payload -> reply payload
+    WIRE_USE = 1,                             // graph name      -> empty
+    WIRE_NEWGRAPH = 2,                        // points          -> u64 count, replacing the graph
+    WIRE_ADDPOINTS = 3,                       // points          -> u64 count
+    WIRE_NEWPOINT = 4,                        // point           -> empty
+    WIRE_REMOVEPOINT = 5,                     // point           -> u8 removed
+    WIRE_CH = 6,                              // empty           -> f32 area
+    WIRE_HULL = 7,                            // empty           -> hull vertices, counter-clockwise
+    WIRE_INSIDE = 8,                          // point           -> u8 inside
+    WIRE_EXTREME = 9,                         // direction       -> point, empty for an empty graph
+    WIRE_DIAMETER = 10,                       // empty           -> f64 diameter, f64 width
+    WIRE_ERROR = 0xFFFF,                      //                 -> message
+};
+
+const size_t kWireHeaderSize = 8;
+
+struct WireHeader {
+    uint32_t length = 0;                      // Payload bytes after the header
+    uint16_t opcode = 0;
+};
+
+bool readWireHeader(const char* data, size_t size, WireHeader& h);   // False if size < kWireHeaderSize
+
+// Builds one frame; the header's length is filled in by data()
+class WireFrame {
+public:
+    explicit WireFrame(uint16_t opcode);
+
+    WireFrame& u8(uint8_t v);
+    WireFrame& u64(uint64_t v);
+    WireFrame& f32(float v);
+    WireFrame& f64(double v);
+    WireFrame& point(const Point& p);
+    WireFrame& points(const std::vector<Point>& P);
+    WireFrame& text(const std::string& s);
+
+    const std::string& data();
+
+private:
+    void putLE(uint64_t v, int bytes);
+
+    std::string buf;
+};
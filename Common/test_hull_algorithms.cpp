@@ -0,0 +1,134 @@
+#include "DynamicHull.hpp"
+#include "Geometry.hpp"
+#include "HullAlgorithms.hpp"
+#include "ParallelHull.hpp"
+#include "RadixSort.hpp"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <string>
+
+static int failures = 0;
+
+// Reference: monotone chain over sorted input
+static std::vector<Point> reference(std::vector<Point> P) {
+    if (P.size() <= 1) return P;
+    sortPoints(P);
+    return hullOfSorted(P.data(), P.size());
+}
+
+// Strictly convex, counter-clockwise, with no input point outside
+static bool encloses(const std::vector<Point>& H, const std::vector<Point>& P) {
+    size_t h = H.size();
+    if (h < 3) return true;
+    for (size_t i = 0; i < h; ++i) {
+        if (cross(H[i], H[(i + 1) % h], H[(i + 2) % h]) <= 0) return false;
+        for (const Point& p : P) {
+            if (cross(H[i], H[(i + 1) % h], p) < 0) return false;
+        }
+    }
+    return true;
+}
+
+static void check(const std::string& what, const std::vector<Point>& got, const std::vector<Point>& want) {
+    if (got != want) {
+        std::cout << "FAIL: " << what << " (" << got.size() << " vertices, expected " << want.size() << ")\n";
+        ++failures;
+    }
+}
+
+// Inserts P one point at a time, erases every third point, then adds the
+// erased points back as one batch; the hull must match at each step
+static void checkDynamic(const std::string& name, const std::vector<Point>& P) {
+    DynamicHull dyn;
+    for (const Point& p : P) dyn.insert(p);
+    check("DynamicHull insert " + name, dyn.hull(), reference(P));
+
+    std::vector<Point> kept, erased;
+    for (size_t i = 0; i < P.size(); ++i) (i % 3 == 0 ? erased : kept).push_back(P[i]);
+    for (const Point& p : erased) dyn.erase(p);
+    check("DynamicHull erase " + name, dyn.hull(), reference(kept));
+
+    dyn.insert(erased);
+    check("DynamicHull batch " + name, dyn.hull(), reference(P));
+    size_t copies = std::count(P.begin(), P.end(), P[0]);
+    if (dyn.size() != P.size() || dyn.count(P[0]) != copies || dyn.erase({1e9f, 1e9f})) {
+        std::cout << "FAIL: DynamicHull size or count " << name << "\n";
+        ++failures;
+    }
+}
+
+// Points within a few ulps of one line, where float orientation tests misjudge turns
+static std::vector<Point> nearCollinear(std::mt19937& rng, size_t n) {
+    std::uniform_real_distribution<float> t(-1000.0f, 1000.0f), slope(-3.0f, 3.0f);
+    std::uniform_int_distribution<int> ulps(-4, 4);
+    float a = slope(rng), b = t(rng);
+    std::vector<Point> P(n);
+    for (Point& p : P) {
+        p.x = t(rng);
+        p.y = a * p.x + b;
+        for (int k = ulps(rng); k != 0; k += k > 0 ? -1 : 1) {
+            p.y = std::nextafter(p.y, k > 0 ? HUGE_VALF : -HUGE_VALF);
+        }
+    }
+    return P;
+}
+
+static std::vector<Point> uniform(std::mt19937& rng, size_t n) {
+    std::uniform_real_distribution<float> u(-1e4f, 1e4f);
+    std::vector<Point> P(n);
+    for (Point& p : P) p = {u(rng), u(rng)};
+    return P;
+}
+
+// Many points on or near a circle, plus duplicates of some of them
+static std::vector<Point> circle(std::mt19937& rng, size_t n) {
+    std::uniform_real_distribution<double> angle(0.0, 6.283185307179586);
+    std::vector<Point> P(n);
+    for (Point& p : P) {
+        double a = angle(rng);
+        p = {static_cast<float>(1e3 * std::cos(a)), static_cast<float>(1e3 * std::sin(a))};
+    }
+    for (size_t i = 0; i < n / 8; ++i) P[i * 7 % n] = P[i];
+    return P;
+}
+
+// Small integer grid: many exact collinear and duplicate points
+static std::vector<Point> grid(std::mt19937& rng, size_t n) {
+    std::uniform_int_distribution<int> u(0, 20);
+    std::vector<Point> P(n);
+    for (Point& p : P) p = {static_cast<float>(u(rng)), static_cast<float>(u(rng))};
+    return P;
+}
+
+int main() {
+    std::mt19937 rng(12345);
+    const std::pair<const char*, std::function<std::vector<Point>(std::mt19937&, size_t)>> shapes[] = {
+        {"near-collinear", nearCollinear}, {"uniform", uniform}, {"circle", circle}, {"grid", grid}};
+    const size_t sizes[] = {1, 2, 3, 10, 100, 2000, 20000};
+
+    for (const auto& shape : shapes) {
+        for (size_t n : sizes) {
+            for (int round = 0; round < 20; ++round) {
+                std::vector<Point> P = shape.second(rng, n);
+                std::vector<Point> want = reference(P);
+                if (n <= 2000 && !encloses(want, P)) {
+                    std::cout << "FAIL: reference hull " << shape.first << " n=" << n << "\n";
+                    ++failures;
+                }
+                std::string name = std::string(shape.first) + " n=" + std::to_string(n) + " round " +
+                                   std::to_string(round);
+                check("quickHull " + name, quickHull(P), want);
+                check("chanHull " + name, chanHull(P), want);
+                check("parallelConvexHull " + name, parallelConvexHull(P, 4), want);
+                check("convexHull " + name, convexHull(P), want);
+                if (round < 5) checkDynamic(name, P);
+            }
+        }
+    }
+
+    std::cout << (failures ? "Hull algorithm tests failed\n" : "Hull algorithm tests passed\n");
+    return failures ? 1 : 0;
+}
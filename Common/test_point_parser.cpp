@@ -0,0 +1,49 @@
+#include "PointParser.hpp"
+#include <cstring>
+#include <iostream>
+
+static int failures = 0;
+
+static void check(bool ok, const char* what) {
+    if (!ok) {
+        std::cout << "FAIL: " << what << "\n";
+        ++failures;
+    }
+}
+
+static const char* parseF(const char* text, float& out) {
+    return parseFloat(text, text + std::strlen(text), out);
+}
+
+static const char* parseP(const char* text, Point& p) {
+    return parsePoint(text, text + std::strlen(text), p);
+}
+
+int main() {
+    float f;
+    Point p;
+
+    // Non-finite values are rejected in every spelling from_chars accepts
+    const char* nonFinite[] = {"nan", "-nan", "NaN", "inf", "-inf", "+inf", "infinity", "1e999"};
+    for (const char* text : nonFinite) check(parseF(text, f) == nullptr, text);
+    check(parseP("nan,nan", p) == nullptr, "nan,nan");
+    check(parseP("inf,1", p) == nullptr, "inf,1");
+    check(parseP("1,inf", p) == nullptr, "1,inf");
+
+    check(parseF("+1", f) && f == 1.0f, "+1");
+    check(parseF("1e3", f) && f == 1000.0f, "1e3");
+    check(parseF("  -2.5", f) && f == -2.5f, "leading blanks");
+
+    // Parsing stops at trailing garbage; a point needs both halves to parse
+    const char* text = "1.5abc";
+    check(parseF(text, f) == text + 3 && f == 1.5f, "1.5abc stops at the garbage");
+    check(parseF("abc", f) == nullptr, "abc");
+    check(parseF("", f) == nullptr, "empty");
+    check(parseP("1.5x,2", p) == nullptr, "1.5x,2");
+    check(parseP("1,", p) == nullptr, "1,");
+    check(parseP("3,4", p) && p.x == 3 && p.y == 4, "3,4");
+    check(parseP("3 4", p) && p.x == 3 && p.y == 4, "3 4");
+
+    std::cout << (failures ? "PointParser tests failed\n" : "PointParser tests passed\n");
+    return failures ? 1 : 0;
+}
@@ -1,65 +1,119 @@
+#include "../Common/Geometry.hpp"
+#include "../Common/StreamingHull.hpp"
+#include "../Common/PointParser.hpp"
+#include "../Common/PointLoader.hpp"
+#include "../Common/PointFile.hpp"
 #include <iostream>
 #include <vector>
-#include <algorithm>
-#include <cmath>
 #include <iomanip>
+#include <cstring>
+#include <cstdlib>
+#include <cerrno>
+#include <algorithm>
+#include <unistd.h>
+#include <utility>
 
-struct Point {
-    float x, y;
-    bool operator<(const Point& p) const {
-        return (x < p.x || (x == p.x && y < p.y));
-    }
-};
-
-float cross(const Point& O, const Point& A, const Point& B) {
-    return (A.x - O.x) * (B.y - O.y) - (A.y - O.y) * (B.x - O.x);
-}
-
-std::vector<Point> convexHull(std::vector<Point>& P) {
-    int n = P.size(), k = 0;
-    if (n <= 1) return P;
-
-    std::sort(P.begin(), P.end());
-    std::vector<Point> H(2 * n);
-
-    // Lower hull
-    for (int i = 0; i < n; ++i) {
-        while (k >= 2 && cross(H[k - 2], H[k - 1], P[i]) <= 0) k--;
-        H[k++] = P[i];
-    }
-
-    // Upper hull
-    for (int i = n - 2, t = k + 1; i >= 0; --i) {
-        while (k >= t && cross(H[k - 2], H[k - 1], P[i]) <= 0) k--;
-        H[k++] = P[i];
-    }
+// Points decoded per step when streaming a binary file that cannot be read in place
+static const size_t kDecodeBlock = 1 << 16;
 
-    H.resize(k - 1);
-    return H;
+// Whether s is a whole unsigned number; value is set when it is
+static bool parseSize(const char* s, size_t& value) {
+    if (*s < '0' || *s > '9') return false;
+    char* end;
+    errno = 0;
+    unsigned long long v = std::strtoull(s, &end, 10);
+    if (*end != '\0' || errno == ERANGE) return false;
+    value = static_cast<size_t>(v);
+    return true;
 }
 
-float polygonArea(const std::vector<Point>& poly) {
-    float area = 0.0;
-    int n = poly.size();
-    for (int i = 0; i < n; ++i) {
-        const Point& p1 = poly[i];
-        const Point& p2 = poly[(i + 1) % n];
-        area += (p1.x * p2.y) - (p2.x * p1.y);
+int main(int argc, char* argv[]) {
+    // --stream [chunk]: fold the input into a running hull chunk by chunk,
+    // so memory stays O(h + chunk) however many points are read
+    bool stream = false;
+    size_t chunk = 1 << 20;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--stream") == 0) {
+            stream = true;
+            size_t value;
+            if (i + 1 < argc && parseSize(argv[i + 1], value)) {   // The chunk size is optional
+                if (value == 0) {
+                    std::cerr << "Chunk size must be positive\n";
+                    return 1;
+                }
+                chunk = value;
+                ++i;
+            }
+        }
     }
-    return std::abs(area) / 2.0f;
-}
 
-int main() {
-    int n;
-    std::cin >> n;
-    std::vector<Point> points(n);
+    std::vector<Point> hull;
+    MappedFile mapped(STDIN_FILENO);
+    size_t count = 0;
+    const Point* view = mappedPoints(mapped, count);
+    if (view) {
+        // Interleaved binary file: the points are read in place from the mapping
+        if (stream) {
+            StreamingHull running(chunk);
+            for (size_t i = 0; i < count; ++i) running.add(view[i]);
+            hull = running.hull();
+        } else {
+            hull = convexHull(std::vector<Point>(view, view + count));
+        }
+    } else if (stream && mapped.valid() && isBinaryPointFile(mapped.data(), mapped.size())) {
+        // SoA or non-finite binary file: decoded a block at a time, never whole
+        PointFileHeader h;
+        if (!readPointFileHeader(mapped.data(), mapped.size(), h)) {
+            std::cerr << "Malformed input\n";
+            return 1;
+        }
+        StreamingHull running(chunk);
+        std::vector<Point> block(std::min<uint64_t>(h.count, kDecodeBlock));
+        for (uint64_t first = 0; first < h.count; first += block.size()) {
+            size_t len = static_cast<size_t>(std::min<uint64_t>(block.size(), h.count - first));
+            decodePointRange(mapped.data(), h, first, len, block.data());
+            for (size_t i = 0; i < len; ++i) {
+                if (!isFinite(block[i])) {
+                    std::cerr << "Malformed input\n";
+                    return 1;
+                }
+                running.add(block[i]);
+            }
+        }
+        hull = running.hull();
+    } else if (mapped.valid() && !stream) {
+        // Any other regular file on stdin is loaded straight from a mapping of it
+        std::vector<Point> points;
+        if (!loadPoints(mapped, points)) {
+            std::cerr << "Malformed input\n";
+            return 1;
+        }
+        hull = convexHull(std::move(points));
+    } else {
+        PointReader reader(stdin);
+        long long n = 0;
+        if (!reader.readCount(n) || n < 0) {
+            std::cerr << "Expected a point count on the first line\n";
+            return 1;
+        }
 
-    char comma;
-    for (int i = 0; i < n; ++i) {
-        std::cin >> points[i].x >> comma >> points[i].y;
+        Point p;
+        if (stream) {
+            StreamingHull running(chunk);
+            for (long long i = 0; i < n && reader.next(p); ++i) {
+                running.add(p);
+            }
+            hull = running.hull();
+        } else {
+            std::vector<Point> points;
+            points.reserve(n);
+            for (long long i = 0; i < n && reader.next(p); ++i) {
+                points.push_back(p);
+            }
+            hull = convexHull(std::move(points));
+        }
     }
 
-    std::vector<Point> hull = convexHull(points);
     float area = polygonArea(hull);
 
     std::cout << std::fixed << std::setprecision(6) << area << std::endl;
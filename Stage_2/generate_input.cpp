@@ -1,22 +1,99 @@
+#include "../Common/PointFile.hpp"
+#include "../Common/PointGenerator.hpp"
 #include <iostream>
-#include <fstream>
+#include <string>
+#include <charconv>
+#include <cstdio>
 #include <cstdlib>
-#include <ctime>
-#include <iomanip>
+#include <cstring>
+#include <vector>
 
-int main() {
-    std::ofstream out("input_large.txt");
-    int n = 10000;
-    out << n << "\n";
+// Usage: generate_input [options] [n] [file]
+//   n                    point count, e.g. 10000 or 1e9 (default 10000)
+//   file                 output path (default input_large.txt, or input_large.bin)
+//   --dist NAME          square, disk, circle, clusters or collinear (default square)
+//   --seed S             generator seed (default 42); the same seed gives the same file
+//   --binary | --soa     binary point file, interleaved or in SoA blocks (see PointFile.hpp)
+// Points are written as they are generated, so n is bounded by disk space only.
+int main(int argc, char* argv[]) {
+    bool binary = false;
+    PointLayout layout = INTERLEAVED;
+    Distribution dist = UNIFORM_SQUARE;
+    uint64_t seed = 42;
+    unsigned long long n = 10000;
+    std::string file;
+    int positional = 0;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--binary") {
+            binary = true;
+        } else if (arg == "--soa") {
+            binary = true;
+            layout = SOA_BLOCKS;
+        } else if (arg == "--dist" && i + 1 < argc) {
+            if (!parseDistribution(argv[++i], dist)) {
+                std::cerr << "Unknown distribution " << argv[i] << "\n";
+                return 1;
+            }
+        } else if (arg == "--seed" && i + 1 < argc) {
+            seed = std::strtoull(argv[++i], nullptr, 10);
+        } else if (arg.compare(0, 2, "--") == 0) {
+            std::cerr << "Unknown or incomplete option " << arg << "\n";
+            return 1;
+        } else if (positional++ == 0) {
+            n = static_cast<unsigned long long>(std::strtod(argv[i], nullptr));
+        } else {
+            file = arg;
+        }
+    }
+    if (file.empty()) file = binary ? "input_large.bin" : "input_large.txt";
 
-    std::srand(std::time(nullptr));
-    for (int i = 0; i < n; ++i) {
-        float x = static_cast<float>(rand() % 10000) / 10.0;
-        float y = static_cast<float>(rand() % 10000) / 10.0;
-        out << std::fixed << std::setprecision(2) << x << "," << y << "\n";
+    PointGenerator gen(dist, seed);
+    if (binary) {
+        PointFileWriter out(file, layout);
+        if (!out.valid()) {
+            std::cerr << "Cannot create " << file << "\n";
+            return 1;
+        }
+        for (unsigned long long i = 0; i < n; ++i) out.add(gen.next());
+        if (!out.close()) {
+            std::cerr << "Write to " << file << " failed\n";
+            return 1;
+        }
+    } else {
+        FILE* out = std::fopen(file.c_str(), "w");
+        if (!out) {
+            std::cerr << "Cannot create " << file << "\n";
+            return 1;
+        }
+        // Shortest round-trip form, so the text file holds exactly the binary file's
+        // floats. Lines are formatted into one buffer and written a block at a time.
+        std::vector<char> buf(1 << 20);
+        size_t len = std::snprintf(buf.data(), buf.size(), "%llu\n", n);
+        bool failed = false;
+        for (unsigned long long i = 0; i < n; ++i) {
+            if (buf.size() - len < 64) {
+                failed |= std::fwrite(buf.data(), 1, len, out) != len;
+                len = 0;
+            }
+            Point p = gen.next();
+            char* cur = buf.data() + len;
+            char* end = buf.data() + buf.size();
+            cur = std::to_chars(cur, end, p.x).ptr;
+            *cur++ = ',';
+            cur = std::to_chars(cur, end, p.y).ptr;
+            *cur++ = '\n';
+            len = cur - buf.data();
+        }
+        failed |= std::fwrite(buf.data(), 1, len, out) != len;
+        failed |= std::fclose(out) != 0;
+        if (failed) {
+            std::cerr << "Write to " << file << " failed\n";
+            return 1;
+        }
     }
 
-    out.close();
-    std::cout << "input_large.txt generated with " << n << " points.\n";
+    std::cout << file << " generated with " << n << " " << distributionName(dist)
+              << " points (seed " << seed << ").\n";
     return 0;
 }
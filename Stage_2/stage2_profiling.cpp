@@ -1,36 +1,26 @@
+#include "../Common/Geometry.hpp"
+#include "../Common/ParallelHull.hpp"
+#include "../Common/Prefilter.hpp"
+#include "../Common/Simd.hpp"
+#include "../Common/RadixSort.hpp"
+#include "../Common/HullAlgorithms.hpp"
+#include "../Common/DynamicHull.hpp"
+#include "../Common/StreamingHull.hpp"
+#include "../Common/PointLoader.hpp"
+#include "../Common/PointArray.hpp"
+#include "../Common/PointGenerator.hpp"
 #include <iostream>
 #include <fstream>
 #include <vector>
 #include <list>
+#include <string>
+#include <functional>
 #include <algorithm>
 #include <chrono>
 #include <cmath>
-#include <sstream>
+#include <cstdlib>
 #include <iomanip>
-
-struct Point {
-    float x, y;
-    bool operator<(const Point& p) const {
-        return (x < p.x || (x == p.x && y < p.y));
-    }
-};
-
-// Cross product
-float cross(const Point& O, const Point& A, const Point& B) {
-    return (A.x - O.x) * (B.y - O.y) - (A.y - O.y) * (B.x - O.x);
-}
-
-// Shoelace formula
-float polygonArea(const std::vector<Point>& poly) {
-    float area = 0.0f;
-    int n = poly.size();
-    for (int i = 0; i < n; ++i) {
-        const Point& p1 = poly[i];
-        const Point& p2 = poly[(i + 1) % n];
-        area += (p1.x * p2.y) - (p2.x * p1.y);
-    }
-    return std::abs(area) / 2.0f;
-}
+#include <cstring>
 
 // Version A: convex hull using vector
 std::vector<Point> convexHullVector(std::vector<Point> P) {
@@ -89,47 +79,333 @@ std::list<Point> convexHullList(std::list<Point> P) {
     return H;
 }
 
+// Loads text or binary point files from a read-only mapping of the file
 std::vector<Point> readInput(const std::string& filename) {
-    std::ifstream in(filename);
-    int n;
-    in >> n;
-    std::vector<Point> points(n);
-    char comma;
-    for (int i = 0; i < n; ++i) {
-        in >> points[i].x >> comma >> points[i].y;
+    std::vector<Point> points;
+    if (!loadPointFile(filename, points)) {
+        std::cerr << "Cannot load " << filename << "\n";
     }
     return points;
 }
 
-int main() {
-    std::string inputFile = "input_large.txt";
-    std::vector<Point> inputPoints = readInput(inputFile);
+// ========== Benchmark cases ==========
+
+struct BenchCase {
+    const char* name;
+    const char* kind;                         // "hull" or "sort"
+    size_t maxN;                              // Skipped above this many points, 0 for no limit
+    std::function<double(const std::vector<Point>&)> run;   // Returns a checksum so the work is kept
+    std::function<size_t(const std::vector<Point>&)> survivors = nullptr;   // Points left by a prefilter, if any
+};
+
+// Points the Akl-Toussaint filter keeps, counted outside the timed runs
+static size_t prefilterSurvivors(const std::vector<Point>& P) {
+    std::vector<Point> filtered = P;
+    aklToussaintFilter(filtered);
+    return filtered.size();
+}
+
+// Area of the hull rotated to start at its smallest vertex, so equal hulls give
+// bit-identical checksums whichever vertex an algorithm starts from
+static double hullChecksum(std::vector<Point> hull) {
+    std::rotate(hull.begin(), std::min_element(hull.begin(), hull.end()), hull.end());
+    return polygonArea(hull);
+}
+
+static double sortChecksum(const std::vector<Point>& P) {
+    return P.empty() ? 0.0 : P[0].x + P[P.size() / 2].x + P.back().y;
+}
+
+// Every hull algorithm and sort in the project; each run starts from a copy of the input
+static std::vector<BenchCase> benchCases() {
+    return {
+        {"vector", "hull", 0, [](const std::vector<Point>& P) {
+            return hullChecksum(convexHullVector(P));
+        }},
+        {"list", "hull", 1000000, [](const std::vector<Point>& P) {   // Includes building the list
+            std::list<Point> H = convexHullList(std::list<Point>(P.begin(), P.end()));
+            return hullChecksum(std::vector<Point>(H.begin(), H.end()));
+        }},
+        {"monotone", "hull", 0, [](const std::vector<Point>& P) {
+            return hullChecksum(runHullAlgorithm(MONOTONE_CHAIN, P));
+        }},
+        {"quickhull", "hull", 0, [](const std::vector<Point>& P) {
+            return hullChecksum(quickHull(P));
+        }},
+        {"chan", "hull", 0, [](const std::vector<Point>& P) {
+            return hullChecksum(chanHull(P));
+        }},
+        {"parallel", "hull", 0, [](const std::vector<Point>& P) {
+            return hullChecksum(parallelConvexHull(P));
+        }},
+        {"prefilter+monotone", "hull", 0, [](const std::vector<Point>& P) {
+            std::vector<Point> filtered = P;
+            aklToussaintFilter(filtered);
+            return hullChecksum(runHullAlgorithm(MONOTONE_CHAIN, std::move(filtered)));
+        }, prefilterSurvivors},
+        {"convexHull", "hull", 0, [](const std::vector<Point>& P) {
+            return hullChecksum(convexHull(P));
+        }, [](const std::vector<Point>& P) {
+            return P.size() < kPrefilterThreshold ? P.size() : prefilterSurvivors(P);
+        }},
+        {"soa convexHull", "hull", 0, [](const std::vector<Point>& P) {   // Includes filling the array
+            PointArray A;
+            A.reserve(P.size());
+            for (const Point& p : P) A.push_back(p);
+            return hullChecksum(convexHull(A));
+        }},
+        {"dynamic", "hull", 100000, [](const std::vector<Point>& P) {
+            DynamicHull hull;
+            for (const Point& p : P) hull.insert(p);
+            return hullChecksum(hull.hull());
+        }},
+        {"streaming", "hull", 0, [](const std::vector<Point>& P) {
+            StreamingHull running;
+            for (const Point& p : P) running.add(p);
+            return hullChecksum(running.hull());
+        }},
+        {"std::sort", "sort", 0, [](const std::vector<Point>& P) {
+            std::vector<Point> S = P;
+            std::sort(S.begin(), S.end());
+            return sortChecksum(S);
+        }},
+        {"parallelSort", "sort", 0, [](const std::vector<Point>& P) {
+            std::vector<Point> S = P;
+            parallelSort(S);
+            return sortChecksum(S);
+        }},
+        {"radix", "sort", 0, [](const std::vector<Point>& P) {
+            std::vector<Point> S = P;
+            radixSort(S.data(), S.size());
+            return sortChecksum(S);
+        }},
+        {"parallel radix", "sort", 0, [](const std::vector<Point>& P) {
+            std::vector<Point> S = P;
+            parallelRadixSort(S);
+            return sortChecksum(S);
+        }},
+        {"sortPoints", "sort", 0, [](const std::vector<Point>& P) {
+            std::vector<Point> S = P;
+            sortPoints(S);
+            return sortChecksum(S);
+        }},
+    };
+}
+
+// ========== Measurement ==========
+
+struct BenchResult {
+    std::string input;                        // Distribution name or input file
+    size_t n;
+    const BenchCase* bench;
+    int reps;
+    double median, p95, best;                 // Seconds
+    double checksum;
+    long long survivors;                      // -1 unless the case prefilters
+};
+
+static BenchResult measure(const BenchCase& bench, const std::string& input,
+                           const std::vector<Point>& P, int warmup, int reps) {
+    double checksum = 0.0;
+    for (int i = 0; i < warmup; ++i) checksum = bench.run(P);
+
+    std::vector<double> times;
+    for (int i = 0; i < reps; ++i) {
+        auto start = std::chrono::steady_clock::now();
+        checksum = bench.run(P);
+        auto end = std::chrono::steady_clock::now();
+        times.push_back(std::chrono::duration<double>(end - start).count());
+    }
+    std::sort(times.begin(), times.end());
+
+    BenchResult r;
+    r.input = input;
+    r.n = P.size();
+    r.bench = &bench;
+    r.reps = reps;
+    r.median = reps % 2 ? times[reps / 2] : (times[reps / 2 - 1] + times[reps / 2]) / 2;
+    r.p95 = times[static_cast<size_t>(std::ceil(0.95 * reps)) - 1];   // Nearest rank
+    r.best = times[0];
+    r.checksum = checksum;
+    r.survivors = bench.survivors ? static_cast<long long>(bench.survivors(P)) : -1;
+    return r;
+}
+
+static double pointsPerSecond(const BenchResult& r) {
+    return r.median > 0 ? r.n / r.median : 0.0;
+}
 
-    // Version A: vector
-    auto startA = std::chrono::high_resolution_clock::now();
-    auto hullA = convexHullVector(inputPoints);
-    float areaA = polygonArea(hullA);
-    auto endA = std::chrono::high_resolution_clock::now();
-    std::chrono::duration<double> timeA = endA - startA;
+// ========== Reporting ==========
 
-    std::cout << "Vector version:\n";
-    std::cout << "  Area: " << areaA << "\n";
-    std::cout << "  Time: " << std::fixed << std::setprecision(6) << timeA.count() << " seconds\n\n";
+static void printHeader() {
+    std::cout << std::left << std::setw(16) << "input" << " " << std::setw(20) << "case"
+              << std::right << std::setw(11) << "n" << std::setw(13) << "median (s)"
+              << std::setw(13) << "p95 (s)" << std::setw(12) << "Mpts/s" << "  checksum\n";
+}
 
-    // Version B: list
-    std::list<Point> listPoints(inputPoints.begin(), inputPoints.end());
-    auto startB = std::chrono::high_resolution_clock::now();
-    auto hullB = convexHullList(listPoints);
+static void printResult(const BenchResult& r) {
+    std::cout << std::left << std::setw(16) << r.input << " " << std::setw(20) << r.bench->name
+              << std::right << std::setw(11) << r.n << std::fixed << std::setprecision(6)
+              << std::setw(13) << r.median << std::setw(13) << r.p95 << std::setprecision(2)
+              << std::setw(12) << pointsPerSecond(r) / 1e6 << "  " << std::defaultfloat
+              << std::setprecision(9) << r.checksum << "\n";
+    if (r.survivors >= 0) {
+        std::cout << std::string(17, ' ') << "prefilter kept " << r.survivors << " of " << r.n << " ("
+                  << std::fixed << std::setprecision(2) << (r.n ? 100.0 * r.survivors / r.n : 0.0)
+                  << "%)\n" << std::defaultfloat;
+    }
+}
 
-    // Convert list hull to vector for area
-    std::vector<Point> hullVecB(hullB.begin(), hullB.end());
-    float areaB = polygonArea(hullVecB);
-    auto endB = std::chrono::high_resolution_clock::now();
-    std::chrono::duration<double> timeB = endB - startB;
+static bool writeCsv(const std::string& path, const std::vector<BenchResult>& results) {
+    std::ofstream out(path);
+    out << "input,n,case,kind,reps,median_s,p95_s,min_s,points_per_s,checksum,survivors\n";
+    out << std::setprecision(9);
+    for (const BenchResult& r : results) {
+        out << r.input << "," << r.n << "," << r.bench->name << "," << r.bench->kind << ","
+            << r.reps << "," << r.median << "," << r.p95 << "," << r.best << ","
+            << pointsPerSecond(r) << "," << r.checksum << ",";
+        if (r.survivors >= 0) out << r.survivors;   // Empty for cases without a prefilter
+        out << "\n";
+    }
+    return static_cast<bool>(out);
+}
 
-    std::cout << "List version:\n";
-    std::cout << "  Area: " << areaB << "\n";
-    std::cout << "  Time: " << std::fixed << std::setprecision(6) << timeB.count() << " seconds\n";
+static bool writeJson(const std::string& path, const std::vector<BenchResult>& results) {
+    std::ofstream out(path);
+    out << std::setprecision(9);
+    out << "{\n  \"simd\": \"" << simdBackend() << "\",\n  \"threads\": " << hullThreads()
+        << ",\n  \"results\": [\n";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const BenchResult& r = results[i];
+        out << "    {\"input\": \"" << r.input << "\", \"n\": " << r.n << ", \"case\": \""
+            << r.bench->name << "\", \"kind\": \"" << r.bench->kind << "\", \"reps\": " << r.reps
+            << ", \"median_s\": " << r.median << ", \"p95_s\": " << r.p95 << ", \"min_s\": " << r.best
+            << ", \"points_per_s\": " << pointsPerSecond(r) << ", \"checksum\": " << r.checksum;
+        if (r.survivors >= 0) out << ", \"survivors\": " << r.survivors;
+        out << "}" << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    out << "  ]\n}\n";
+    return static_cast<bool>(out);
+}
 
+// ========== Command line ==========
+
+static std::vector<std::string> splitList(const std::string& s) {
+    std::vector<std::string> items;
+    size_t start = 0;
+    while (start <= s.size()) {
+        size_t comma = std::min(s.find(',', start), s.size());
+        if (comma > start) items.push_back(s.substr(start, comma - start));
+        start = comma + 1;
+    }
+    return items;
+}
+
+// Usage: stage2_profiling [file] [options]
+//   Without --bench, times every case on the points of file (input_large.txt).
+//   --bench              sweep generated inputs instead of reading a file
+//   --sizes 1e3,1e4,...  point counts for --bench (default 1e3,1e4,1e5,1e6)
+//   --dist square,...    distributions for --bench (default all)
+//   --cases name,...     only these cases (default all)
+//   --warmup W --reps R  untimed and timed runs per case (default 1 and 5)
+//   --seed S             generator seed (default 42)
+//   --csv FILE --json FILE
+int main(int argc, char* argv[]) {
+    std::string inputFile = "input_large.txt", csvFile, jsonFile;
+    std::vector<std::string> sizes = {"1e3", "1e4", "1e5", "1e6"}, dists, caseNames;
+    bool sweep = false;
+    int warmup = 1, reps = 5;
+    uint64_t seed = 42;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--bench") sweep = true;
+        else if (arg == "--sizes" && hasValue) sizes = splitList(argv[++i]);
+        else if (arg == "--dist" && hasValue) dists = splitList(argv[++i]);
+        else if (arg == "--cases" && hasValue) caseNames = splitList(argv[++i]);
+        else if (arg == "--warmup" && hasValue) warmup = std::max(0, std::atoi(argv[++i]));
+        else if (arg == "--reps" && hasValue) reps = std::max(1, std::atoi(argv[++i]));
+        else if (arg == "--seed" && hasValue) seed = std::strtoull(argv[++i], nullptr, 10);
+        else if (arg == "--csv" && hasValue) csvFile = argv[++i];
+        else if (arg == "--json" && hasValue) jsonFile = argv[++i];
+        else if (arg.compare(0, 2, "--") == 0) {
+            std::cerr << "Unknown or incomplete option " << arg << "\n";
+            return 1;
+        } else inputFile = arg;
+    }
+
+    std::vector<BenchCase> all = benchCases();
+    std::vector<const BenchCase*> cases;
+    for (const BenchCase& c : all) {
+        if (caseNames.empty() || std::find(caseNames.begin(), caseNames.end(), c.name) != caseNames.end()) {
+            cases.push_back(&c);
+        }
+    }
+
+    std::cout << "SIMD backend: " << simdBackend() << ", threads: " << hullThreads()
+              << ", warmup " << warmup << ", reps " << reps << "\n\n";
+    printHeader();
+
+    // Every hull case must find the same hull as the first one run on an input
+    std::vector<BenchResult> results;
+    int mismatches = 0;
+    auto runAll = [&](const std::string& input, const std::vector<Point>& P) {
+        const BenchCase* reference = nullptr;
+        double expected = 0.0;
+        for (const BenchCase* c : cases) {
+            if (c->maxN && P.size() > c->maxN) continue;
+            results.push_back(measure(*c, input, P, warmup, reps));
+            printResult(results.back());
+
+            if (std::strcmp(c->kind, "hull") != 0) continue;
+            double checksum = results.back().checksum;
+            if (!reference) {
+                reference = c;
+                expected = checksum;
+            } else if (checksum != expected) {
+                std::cerr << std::setprecision(9) << "Hull mismatch on " << input << ", n = " << P.size()
+                          << ": " << c->name << " gives " << checksum << ", " << reference->name
+                          << " gives " << expected << "\n";
+                ++mismatches;
+            }
+        }
+    };
+
+    if (sweep) {
+        std::vector<Distribution> selected;
+        for (const std::string& name : dists) {
+            Distribution d;
+            if (!parseDistribution(name, d)) {
+                std::cerr << "Unknown distribution " << name << "\n";
+                return 1;
+            }
+            selected.push_back(d);
+        }
+        if (selected.empty()) selected.assign(std::begin(kDistributions), std::end(kDistributions));
+
+        for (const std::string& size : sizes) {
+            size_t n = static_cast<size_t>(std::strtod(size.c_str(), nullptr));
+            for (Distribution d : selected) {
+                runAll(distributionName(d), generatePoints(d, n, seed));
+            }
+        }
+    } else {
+        std::vector<Point> inputPoints = readInput(inputFile);
+        if (inputPoints.empty()) return 1;
+        runAll(inputFile, inputPoints);
+    }
+
+    if (!csvFile.empty() && !writeCsv(csvFile, results)) {
+        std::cerr << "Cannot write " << csvFile << "\n";
+        return 1;
+    }
+    if (!jsonFile.empty() && !writeJson(jsonFile, results)) {
+        std::cerr << "Cannot write " << jsonFile << "\n";
+        return 1;
+    }
+    if (mismatches) {
+        std::cerr << mismatches << " hull case(s) disagreed with the others\n";
+        return 2;
+    }
     return 0;
 }
@@ -1,54 +1,138 @@
 #include "Reactor.hpp"
-#include <sys/select.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
 #include <unistd.h>
+#include <cerrno>
 #include <iostream>
 
-Reactor::Reactor() : running(false) {}
+static const int kMaxEvents = 256;            // Events taken per epoll_wait()
+static const int kWaitMillis = 1000;          // How often run() rechecks `running`
+
+// Writes what the socket takes without blocking: the byte count, or -1 on error
+static ssize_t writeSome(int fd, const char* data, size_t len) {
+    size_t done = 0;
+    while (done < len) {
+        ssize_t n = ::send(fd, data + done, len - done, MSG_DONTWAIT | MSG_NOSIGNAL);
+        if (n > 0) {
+            done += n;
+        } else if (n < 0 && errno == EINTR) {
+            continue;
+        } else if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            break;
+        } else {
+            return -1;
+        }
+    }
+    return static_cast<ssize_t>(done);
+}
+
+// Interest for an fd with `pending` bytes queued
+static uint32_t interestFor(size_t pending) {
+    uint32_t events = 0;
+    if (pending < Reactor::kHighWater) events |= EPOLLIN;
+    if (pending > 0) events |= EPOLLOUT;
+    return events;
+}
+
+Reactor::Reactor(Trigger trigger) : epfd(epoll_create1(EPOLL_CLOEXEC)), trigger(trigger), running(false) {
+    if (epfd < 0) perror("epoll_create1");
+}
 
 Reactor::~Reactor() {
     // Does not delete automatically – user controls destruction
     stop();
+    if (epfd >= 0) close(epfd);
 }
 
 bool Reactor::addFd(int fd, reactorFunc func) {
-    if (fds.count(fd)) return false;
-    fds.insert(fd);
+    if (handlers.count(fd)) return false;
+    epoll_event ev{};
+    ev.events = EPOLLIN;
+    if (trigger == EDGE) ev.events |= EPOLLET;
+    ev.data.fd = fd;
+    if (epoll_ctl(epfd, EPOLL_CTL_ADD, fd, &ev) < 0) return false;
     handlers[fd] = func;
     return true;
 }
 
 bool Reactor::removeFd(int fd) {
-    if (!fds.count(fd)) return false;
-    fds.erase(fd);
+    if (!handlers.count(fd)) return false;
+    // Fails harmlessly if the fd was already closed, which removed it from epoll
+    epoll_ctl(epfd, EPOLL_CTL_DEL, fd, nullptr);
     handlers.erase(fd);
+    outputs.erase(fd);
     return true;
 }
 
-void Reactor::run() {
-    running = true;
-    while (running) {
-        fd_set readfds;
-        FD_ZERO(&readfds);
-        int maxfd = 0;
+bool Reactor::send(int fd, const char* data, size_t len) {
+    if (!handlers.count(fd)) return false;
+
+    // Nothing queued: hand the bytes to the socket and queue only the rest
+    auto it = outputs.find(fd);
+    if (it == outputs.end()) {
+        ssize_t n = writeSome(fd, data, len);
+        if (n < 0) return false;
+        if (static_cast<size_t>(n) == len) return true;
+        data += n;
+        len -= n;
+        it = outputs.emplace(fd, Output()).first;
+    }
 
-        for (int fd : fds) {
-            FD_SET(fd, &readfds);
-            if (fd > maxfd) maxfd = fd;
-        }
+    size_t before = it->second.pending();
+    it->second.data.append(data, len);
+    updateInterest(fd, before);
+    return true;
+}
 
-        timeval tv;
-        tv.tv_sec = 1;
-        tv.tv_usec = 0;
+bool Reactor::flush(int fd, Output& out) {
+    ssize_t n = writeSome(fd, out.data.data() + out.sent, out.pending());
+    if (n < 0) return false;
+    out.sent += n;
+    // Drop the written prefix once it is most of the buffer, keeping appends amortized O(1)
+    if (out.sent > out.data.size() / 2) {
+        out.data.erase(0, out.sent);
+        out.sent = 0;
+    }
+    return true;
+}
 
-        int activity = select(maxfd + 1, &readfds, nullptr, nullptr, &tv);
-        if (activity < 0) continue;
+void Reactor::updateInterest(int fd, size_t before) {
+    auto it = outputs.find(fd);
+    size_t pending = it == outputs.end() ? 0 : it->second.pending();
+    uint32_t events = interestFor(pending);
+    if (events == interestFor(before)) return;
+
+    epoll_event ev{};
+    ev.events = events;
+    if (trigger == EDGE) ev.events |= EPOLLET;
+    ev.data.fd = fd;
+    epoll_ctl(epfd, EPOLL_CTL_MOD, fd, &ev);
+}
 
-        for (int fd : fds) {
-            if (FD_ISSET(fd, &readfds)) {
-                if (handlers.count(fd)) {
-                    handlers[fd](fd);
+void Reactor::run() {
+    running = true;
+    epoll_event events[kMaxEvents];
+    while (running) {
+        int n = epoll_wait(epfd, events, kMaxEvents, kWaitMillis);
+        if (n < 0) continue;
+
+        // Errors and hangups go to the handler too, whose read() then sees them.
+        // A handler may remove other fds of this batch, so each is looked up afresh.
+        for (int i = 0; i < n; ++i) {
+            int fd = events[i].data.fd;
+            if (events[i].events & EPOLLOUT) {
+                auto out = outputs.find(fd);
+                if (out != outputs.end()) {
+                    size_t before = out->second.pending();
+                    // On a write error the peer is gone; its handler sees that on read
+                    if (!flush(fd, out->second) || out->second.pending() == 0) outputs.erase(out);
+                    updateInterest(fd, before);
                 }
             }
+            if (events[i].events & (EPOLLIN | EPOLLERR | EPOLLHUP)) {
+                auto it = handlers.find(fd);
+                if (it != handlers.end()) it->second(fd);
+            }
         }
     }
 }
@@ -65,6 +149,10 @@ void* startReactor() {
     return static_cast<void*>(new Reactor());
 }
 
+void* startEdgeTriggeredReactor() {
+    return static_cast<void*>(new Reactor(Reactor::EDGE));
+}
+
 int addFdToReactor(void* reactor, int fd, reactorFunc func) {
     return static_cast<Reactor*>(reactor)->addFd(fd, func) ? 0 : -1;
 }
@@ -73,6 +161,10 @@ int removeFdFromReactor(void* reactor, int fd) {
     return static_cast<Reactor*>(reactor)->removeFd(fd) ? 0 : -1;
 }
 
+int sendViaReactor(void* reactor, int fd, const char* data, size_t len) {
+    return static_cast<Reactor*>(reactor)->send(fd, data, len) ? 0 : -1;
+}
+
 int stopReactor(void* reactor) {
     static_cast<Reactor*>(reactor)->stop();
     return 0;
@@ -1,31 +1,62 @@
 #pragma once
-#include <set>
+#include <atomic>
+#include <cstddef>
+#include <string>
 #include <unordered_map>
 
 // Function that is called when the fd is ready for reading
 typedef void* (*reactorFunc)(int fd);
 
-// Internal Reactor class
+// Internal Reactor class, built on epoll: each wakeup costs O(ready fds),
+// with no FD_SETSIZE limit on descriptor numbers.
+//
+// LEVEL reports an fd on every wakeup while it stays readable, like select().
+// EDGE reports it once per new arrival of data, so its handler must read
+// until EAGAIN (the fd should be non-blocking).
+//
+// Replies go through send(), which never blocks: whatever the socket does not
+// take at once is queued per fd and flushed as the fd becomes writable. Write
+// interest is registered only while a queue is non-empty, and reading from an
+// fd pauses while its queue is over kHighWater, so a slow reader cannot make
+// the server buffer without bound.
 class Reactor {
 public:
-    Reactor();
+    enum Trigger { LEVEL, EDGE };
+
+    explicit Reactor(Trigger trigger = LEVEL);
     ~Reactor();
 
     bool addFd(int fd, reactorFunc func);     // Add fd with its associated function
-    bool removeFd(int fd);                    // Remove fd
-    void run();                               // Start the select loop
+    bool removeFd(int fd);                    // Remove fd, dropping unsent output
+    bool send(int fd, const char* data, size_t len);  // False if fd is unknown or the peer is gone
+    void run();                               // Start the event loop
     void stop();                              // Stop the loop
+
+    static const size_t kHighWater = 1 << 20; // Queued bytes that pause reading
 private:
-    std::set<int> fds;                        // Set of monitored file descriptors
+    struct Output {
+        std::string data;
+        size_t sent = 0;                      // Bytes of data already written
+        size_t pending() const { return data.size() - sent; }
+    };
+
+    bool flush(int fd, Output& out);          // Writes until EAGAIN; false on error
+    void updateInterest(int fd, size_t before);  // Re-arms epoll if the queue crossed 0 or kHighWater
+
+    int epfd;                                 // epoll instance
+    Trigger trigger;
     std::unordered_map<int, reactorFunc> handlers;  // Map from fd to handler function
-    bool running;                             // Is the reactor currently running?
+    std::unordered_map<int, Output> outputs;  // Unsent bytes, only for fds that have some
+    std::atomic<bool> running;                // Is the reactor currently running?
 };
 
 // C interface as required by the assignment
 extern "C" {
-    void* startReactor();                               // Create a new reactor
+    void* startReactor();                               // Create a new (level-triggered) reactor
+    void* startEdgeTriggeredReactor();                  // Same, edge-triggered
     int addFdToReactor(void* reactor, int fd, reactorFunc func);
     int removeFdFromReactor(void* reactor, int fd);
+    int sendViaReactor(void* reactor, int fd, const char* data, size_t len);  // Non-blocking send
     int stopReactor(void* reactor);                     // Only stops – does not delete
     void runReactor(void* reactor);                     // Must be called by the user
 }
@@ -1,10 +1,32 @@
 #include "Reactor.hpp"
 #include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
 #include <unistd.h>  // pipe, read, write
+#include <fcntl.h>   // O_NONBLOCK
+#include <dirent.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/time.h>
 #include <cstring>
 #include <thread>
+#include <atomic>
 #include <chrono>
 
+static int failures = 0;
+
+static void check(bool ok, const char* what) {
+    if (!ok) {
+        std::cout << "FAIL: " << what << "\n";
+        ++failures;
+    }
+}
+
+std::string edgeReceived;
+std::string queueReceived;
+std::atomic<size_t> queueBytes{0};             // Polled by the main thread while the reactor runs
+
 void* myCallback(int fd) {
     char buffer[128];
     int n = read(fd, buffer, sizeof(buffer)-1);
@@ -15,27 +37,152 @@ void* myCallback(int fd) {
     return nullptr;
 }
 
+// Edge-triggered: reads until the non-blocking pipe is empty
+void* drainCallback(int fd) {
+    char buffer[128];
+    int n;
+    while ((n = read(fd, buffer, sizeof(buffer)-1)) > 0) {
+        buffer[n] = '\0';
+        edgeReceived.append(buffer, n);
+        std::cout << "[Edge Reactor] Received: " << buffer;
+    }
+    return nullptr;
+}
+
+void* queueCallback(int fd) {
+    char buffer[128];
+    ssize_t n = recv(fd, buffer, sizeof(buffer), MSG_DONTWAIT);
+    if (n > 0) {
+        queueReceived.append(buffer, n);
+        queueBytes += n;
+    }
+    return nullptr;
+}
+
+// Read/write interest an epoll instance of this process has on fd, read back
+// from the kernel through /proc (which also lists the implicit EPOLLERR and
+// EPOLLHUP); -1 if no instance watches it
+static long watchedEvents(int fd) {
+    DIR* dir = opendir("/proc/self/fdinfo");
+    if (!dir) return -1;
+    long events = -1;
+    while (dirent* entry = readdir(dir)) {
+        std::ifstream info(std::string("/proc/self/fdinfo/") + entry->d_name);
+        std::string line;
+        while (std::getline(info, line)) {
+            std::istringstream fields(line);
+            std::string key, eventsKey;
+            int tfd;
+            std::string mask;
+            if (fields >> key >> tfd >> eventsKey >> mask && key == "tfd:" && tfd == fd) {
+                events = std::stol(mask, nullptr, 16) & (EPOLLIN | EPOLLOUT);
+            }
+        }
+    }
+    closedir(dir);
+    return events;
+}
+
+// Queues more than the socket takes, then checks that every byte arrives in
+// order, that reading pauses past kHighWater, and that EPOLLOUT interest is
+// dropped once the queue has drained
+static void testOutputQueue() {
+    int sv[2];
+    socketpair(AF_UNIX, SOCK_STREAM, 0, sv);
+    int small = 4096;
+    setsockopt(sv[0], SOL_SOCKET, SO_SNDBUF, &small, sizeof(small));
+    fcntl(sv[0], F_SETFL, O_NONBLOCK);
+    timeval timeout = {5, 0};
+    setsockopt(sv[1], SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+    void* reactor = startReactor();
+    addFdToReactor(reactor, sv[0], queueCallback);
+
+    std::string data(3 * Reactor::kHighWater, '\0');
+    for (size_t i = 0; i < data.size(); ++i) data[i] = static_cast<char>(i % 251);
+    const size_t chunk = 100000;
+    bool queued = true;
+    for (size_t i = 0; i < data.size(); i += chunk) {
+        size_t len = std::min(chunk, data.size() - i);
+        queued &= sendViaReactor(reactor, sv[0], data.data() + i, len) == 0;
+    }
+    check(queued, "sendViaReactor accepts everything while the peer is not reading");
+    check(watchedEvents(sv[0]) == EPOLLOUT, "over kHighWater: EPOLLOUT only, reading paused");
+
+    std::thread runner([&]() { runReactor(reactor); });
+
+    std::string got;
+    char buffer[65536];
+    while (got.size() < data.size()) {
+        ssize_t n = recv(sv[1], buffer, sizeof(buffer), 0);
+        if (n <= 0) break;
+        got.append(buffer, n);
+    }
+    check(got == data, "every queued byte arrives, in order");
+
+    // The last flush drops write interest and resumes reading
+    long events = -1;
+    for (int i = 0; i < 100 && events != EPOLLIN; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        events = watchedEvents(sv[0]);
+    }
+    check(events == EPOLLIN, "drained: EPOLLOUT interest dropped, EPOLLIN back");
+
+    send(sv[1], "ping", 4, 0);
+    for (int i = 0; i < 100 && queueBytes < 4; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    stopReactor(reactor);
+    runner.join();
+    check(queueReceived == "ping", "reading resumes once the queue drains");
+    std::cout << "[Queue Reactor] Delivered " << got.size() << " queued bytes\n";
+
+    removeFdFromReactor(reactor, sv[0]);
+    delete static_cast<Reactor*>(reactor);
+    close(sv[0]);
+    close(sv[1]);
+}
+
 int main() {
     int fds[2]; // pipe: fds[0] for reading, fds[1] for writing
     pipe(fds);
 
+    int edgeFds[2];
+    pipe(edgeFds);
+    fcntl(edgeFds[0], F_SETFL, O_NONBLOCK);
+
     void* reactor = startReactor();
     addFdToReactor(reactor, fds[0], myCallback);
 
+    void* edgeReactor = startEdgeTriggeredReactor();
+    addFdToReactor(edgeReactor, edgeFds[0], drainCallback);
+
     std::thread writer([&]() {
         std::this_thread::sleep_for(std::chrono::seconds(1));
         write(fds[1], "Hello!\n", 7);
+        write(edgeFds[1], "Hello, edge!\n", 13);
     });
 
     std::thread runner([&]() {
         runReactor(reactor);  // this blocks
     });
+    std::thread edgeRunner([&]() {
+        runReactor(edgeReactor);
+    });
 
     std::this_thread::sleep_for(std::chrono::seconds(3));
     stopReactor(reactor);
+    stopReactor(edgeReactor);
 
     runner.join();
+    edgeRunner.join();
     writer.join();
 
-    return 0;
+    check(edgeReceived == "Hello, edge!\n", "edge-triggered handler reads the whole message");
+
+    testOutputQueue();
+
+    if (failures) std::cout << failures << " check(s) failed\n";
+    return failures ? 1 : 0;
 }
@@ -6,9 +6,15 @@
 #include <algorithm>
 #include <netinet/in.h>
 #include <unistd.h>
+#include <cerrno>
 #include <string>
 #include <cstring>
 #include <iomanip>
+#include <mutex>
+#include <thread>
+#include <cstdlib>
+#include <pthread.h>
+#include <sched.h>
 
 #define PORT 9034
 #define BUFFER_SIZE 1024
@@ -29,10 +35,13 @@ struct Point {
 
 // ========== Global Graph and State ==========
 
+// The graph is shared by every reactor thread; a connection and its state
+// belong to the one reactor that accepted it, so those are thread_local.
 std::vector<Point> global_graph;
-std::unordered_map<int, int> client_expected_points;
-std::unordered_map<int, std::string> client_buffers;
-void* reactor = nullptr; // global pointer to reactor
+std::mutex graph_mutex;
+thread_local std::unordered_map<int, int> client_expected_points;
+thread_local std::unordered_map<int, std::string> client_buffers;
+thread_local void* reactor = nullptr; // this thread's reactor
 
 // ========== Geometry ==========
 
@@ -81,7 +90,9 @@ std::string trim(const std::string& s) {
 void* handle_client(int fd) {
     char buffer[BUFFER_SIZE];
     int bytes_read = read(fd, buffer, sizeof(buffer) - 1);
+    if (bytes_read < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) return nullptr;
     if (bytes_read <= 0) {
+        removeFdFromReactor(reactor, fd);    // Before close(), or a reused fd number is refused
         close(fd);
         client_expected_points.erase(fd);
         client_buffers.erase(fd);
@@ -107,7 +118,10 @@ void* handle_client(int fd) {
             std::istringstream ps(line);
             float x, y;
             ps >> x >> y;
-            global_graph.push_back({x, y});
+            {
+                std::lock_guard<std::mutex> lock(graph_mutex);
+                global_graph.push_back({x, y});
+            }
             client_expected_points[fd]--;
             continue;
         }
@@ -119,10 +133,13 @@ void* handle_client(int fd) {
         if (cmd == "Newgraph") {
             int n;
             iss >> n;
-            global_graph.clear();
+            {
+                std::lock_guard<std::mutex> lock(graph_mutex);
+                global_graph.clear();
+            }
             client_expected_points[fd] = n;
             std::string msg = "Expecting " + std::to_string(n) + " point(s)...\n";
-            send(fd, msg.c_str(), msg.size(), 0);
+            sendViaReactor(reactor, fd, msg.c_str(), msg.size());
         } else if (cmd == "Newpoint") {
             std::string rest;
             std::getline(iss, rest);
@@ -130,6 +147,7 @@ void* handle_client(int fd) {
             std::istringstream ps(rest);
             float x, y;
             ps >> x >> y;
+            std::lock_guard<std::mutex> lock(graph_mutex);
             global_graph.push_back({x, y});
         } else if (cmd == "Removepoint") {
             std::string rest;
@@ -139,20 +157,27 @@ void* handle_client(int fd) {
             float x, y;
             ps >> x >> y;
             Point target = {x, y};
+            std::lock_guard<std::mutex> lock(graph_mutex);
             auto it = std::find(global_graph.begin(), global_graph.end(), target);
             if (it != global_graph.end()) {
                 global_graph.erase(it);
             }
         } else if (cmd == "CH") {
-            std::vector<Point> hull = convexHull(global_graph);
+            std::vector<Point> points;
+            {
+                // Copy under the lock so the hull is computed without holding it
+                std::lock_guard<std::mutex> lock(graph_mutex);
+                points = global_graph;
+            }
+            std::vector<Point> hull = convexHull(points);
             float area = polygonArea(hull);
             std::ostringstream oss;
             oss << std::fixed << std::setprecision(6) << area << "\n";
             std::string out = oss.str();
-            send(fd, out.c_str(), out.size(), 0);
+            sendViaReactor(reactor, fd, out.c_str(), out.size());
         } else {
             std::string msg = "Unknown command\n";
-            send(fd, msg.c_str(), msg.size(), 0);
+            sendViaReactor(reactor, fd, msg.c_str(), msg.size());
         }
     }
 
@@ -164,25 +189,34 @@ void* handle_client(int fd) {
 void* accept_handler(int fd) {
     sockaddr_in client_addr{};
     socklen_t addrlen = sizeof(client_addr);
-    int client_fd = accept(fd, (sockaddr*)&client_addr, &addrlen);
-    if (client_fd >= 0) {
-        std::cout << "New connection: " << client_fd << "\n";
-        addFdToReactor(reactor, client_fd, handle_client);
+    // Non-blocking, so a spurious wakeup cannot stall the loop in read()
+    int client_fd = accept4(fd, (sockaddr*)&client_addr, &addrlen, SOCK_NONBLOCK);
+    if (client_fd < 0) {
+        // Nothing left to accept, or the client hung up first: wait for the next wakeup
+        if (errno != EAGAIN && errno != EWOULDBLOCK && errno != ECONNABORTED) perror("accept");
+        return nullptr;
     }
+    std::cout << "New connection: " << client_fd << "\n";
+    addFdToReactor(reactor, client_fd, handle_client);
     return nullptr;
 }
 
-// ========== Main ==========
+// ========== Reactor Threads ==========
 
-int main() {
-    int server_fd = socket(AF_INET, SOCK_STREAM, 0);
+// Each reactor has its own listening socket on PORT. With SO_REUSEPORT the
+// kernel spreads incoming connections across them, so no accept thread or
+// hand-off is needed. The listener is non-blocking: a connection reset between
+// the wakeup and accept() must not stall the reactor inside accept().
+int open_listener() {
+    int server_fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK, 0);
     if (server_fd < 0) {
         perror("socket");
-        return 1;
+        return -1;
     }
 
     int yes = 1;
     setsockopt(server_fd, SOL_SOCKET, SO_REUSEADDR, &yes, sizeof(int));
+    setsockopt(server_fd, SOL_SOCKET, SO_REUSEPORT, &yes, sizeof(int));
 
     sockaddr_in server_addr{};
     server_addr.sin_family = AF_INET;
@@ -191,20 +225,84 @@ int main() {
 
     if (bind(server_fd, (sockaddr*)&server_addr, sizeof(server_addr)) < 0) {
         perror("bind");
-        return 2;
+        close(server_fd);
+        return -1;
     }
 
-    if (listen(server_fd, 10) < 0) {
+    if (listen(server_fd, SOMAXCONN) < 0) {
         perror("listen");
-        return 3;
+        close(server_fd);
+        return -1;
     }
+    return server_fd;
+}
 
-    std::cout << "Server (Stage 6) running on port " << PORT << "...\n";
+// The CPUs this process may run on, which under taskset or a cgroup cpuset
+// need not be 0..n-1; falls back to that range if the mask cannot be read
+std::vector<int> allowed_cpus() {
+    std::vector<int> cpus;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+        for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+            if (CPU_ISSET(cpu, &set)) cpus.push_back(cpu);
+        }
+    }
+    if (cpus.empty()) {
+        unsigned cores = std::max(1u, std::thread::hardware_concurrency());
+        for (unsigned cpu = 0; cpu < cores; ++cpu) cpus.push_back(cpu);
+    }
+    return cpus;
+}
 
+// Pins the calling thread to one CPU; a failure only costs locality
+void pin_to_cpu(int cpu) {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+}
+
+void run_reactor(int server_fd) {
     reactor = startReactor();
     addFdToReactor(reactor, server_fd, accept_handler);
     runReactor(reactor);
     stopReactor(reactor);
+    delete static_cast<Reactor*>(reactor);
     close(server_fd);
+}
+
+// ========== Main ==========
+
+// Usage: ./stage6_server [reactors]   (default 1; 0 means one per allowed CPU)
+int main(int argc, char* argv[]) {
+    std::vector<int> cpus = allowed_cpus();
+    unsigned reactors = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 1;
+    if (reactors == 0) reactors = cpus.size();
+
+    // Open every listener before serving, so a bind failure stops startup
+    std::vector<int> listeners;
+    for (unsigned i = 0; i < reactors; ++i) {
+        int server_fd = open_listener();
+        if (server_fd < 0) return 2;
+        listeners.push_back(server_fd);
+    }
+
+    std::cout << "Server (Stage 6) running on port " << PORT << " with "
+              << reactors << " reactor(s)...\n";
+
+    if (reactors == 1) {
+        run_reactor(listeners[0]);
+        return 0;
+    }
+
+    std::vector<std::thread> threads;
+    for (unsigned i = 0; i < reactors; ++i) {
+        threads.emplace_back([cpu = cpus[i % cpus.size()], fd = listeners[i]] {
+            pin_to_cpu(cpu);
+            run_reactor(fd);
+        });
+    }
+    for (auto& t : threads) t.join();
     return 0;
 }
@@ -1,9 +1,14 @@
 // stage9_server.cpp
 #include "../Stage_8/Reactor.hpp"
+#include "../Common/Geometry.hpp"
+#include "../Common/GraphRegistry.hpp"
+#include "../Common/PointParser.hpp"
+#include "../Common/PointFile.hpp"
+#include "../Common/TaskPool.hpp"
+#include "../Common/WireProtocol.hpp"
 #include <iostream>
 #include <sstream>
 #include <vector>
-#include <unordered_map>
 #include <algorithm>
 #include <netinet/in.h>
 #include <unistd.h>
@@ -11,166 +16,466 @@
 #include <arpa/inet.h>
 #include <iomanip>
 #include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <cerrno>
+#include <poll.h>
+#include <sys/eventfd.h>
 
 #define PORT 9034
-#define BUFFER_SIZE 1024
+#define BUFFER_SIZE 65536
 
-struct Point {
-    float x, y;
-    bool operator==(const Point& other) const {
-        return x == other.x && y == other.y;
-    }
-    bool operator<(const Point& p) const {
-        return (x < p.x || (x == p.x && y < p.y));
-    }
-};
+// Shared state: named graphs, each with its own lock. Clients start on
+// kDefaultGraph and switch with "Use <name>" or "Newgraph <name> n"; the
+// registry refuses new names past its cap.
+GraphRegistry graphs;
+const char* const kDefaultGraph = "default";
+Graph* const default_graph = graphs.get(kDefaultGraph);
+const long long kMaxBinaryPoints = 1LL << 26;   // 512 MiB per binary upload
+const size_t kMaxWirePayload = kMaxBinaryPoints * 8;
 
-// Shared state
-std::vector<Point> global_graph;
-std::unordered_map<int, int> client_graph_input_remaining;
-std::mutex graph_mutex;
-std::mutex client_state_mutex;
+// Tagged mode: "#id CMD ..." is answered "#id result". Tagged reads run here
+// and reply as they finish, so one connection can keep many in flight.
+TaskPool query_pool;
 
 // Utilities
-float cross(const Point& O, const Point& A, const Point& B) {
-    return (A.x - O.x) * (B.y - O.y) - (A.y - O.y) * (B.x - O.x);
+std::string trim(const std::string& s) {
+    size_t start = s.find_first_not_of(" \t\r\n");
+    size_t end = s.find_last_not_of(" \t\r\n");
+    return (start == std::string::npos) ? "" : s.substr(start, end - start + 1);
 }
 
-std::vector<Point> convexHull(std::vector<Point> P) {
-    int n = P.size(), k = 0;
-    if (n <= 1) return P;
-    std::sort(P.begin(), P.end());
-    std::vector<Point> H(2 * n);
-    for (int i = 0; i < n; ++i) {
-        while (k >= 2 && cross(H[k - 2], H[k - 1], P[i]) <= 0) k--;
-        H[k++] = P[i];
+// Replies to tagged reads are computed on pool threads but always written by
+// the connection's own thread: a worker only queues its reply and signals
+// wakeFd, so a client that stops reading stalls nothing but its own handler.
+// At most kMaxInFlight reads per connection are running, and begin() sends
+// finished replies while it waits for room. Every other command first waits
+// for all reads and their replies, which keeps each client's reads ordered
+// with respect to its own writes. finish() signals under the lock, so once
+// wait() returns no worker touches the Pipeline again.
+struct Pipeline {
+    static const unsigned kMaxInFlight = 64;
+
+    int fd;                              // The client socket
+    int wakeFd;                          // eventfd, signalled when a reply is queued
+    unsigned inFlight = 0;
+    std::deque<std::string> done;        // Finished replies not yet sent
+    std::mutex mutex;
+    std::condition_variable finished;
+    bool broken = false;                 // A send failed: the peer is gone
+
+    explicit Pipeline(int fd) : fd(fd), wakeFd(eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)) {}
+    ~Pipeline() { close(wakeFd); }
+
+    // Handler thread: takes a slot for one more read
+    void begin() {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true) {
+            flush(lock);
+            if (inFlight < kMaxInFlight) break;
+            finished.wait(lock, [this] { return !done.empty(); });
+        }
+        ++inFlight;
     }
-    for (int i = n - 2, t = k + 1; i >= 0; --i) {
-        while (k >= t && cross(H[k - 2], H[k - 1], P[i]) <= 0) k--;
-        H[k++] = P[i];
+    // Pool thread: hands its reply to the handler thread
+    void finish(std::string reply) {
+        std::lock_guard<std::mutex> lock(mutex);
+        done.push_back(std::move(reply));
+        --inFlight;
+        finished.notify_all();
+        eventfd_write(wakeFd, 1);
+    }
+    // Handler thread: returns once every read has finished and been answered
+    void wait() {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true) {
+            flush(lock);
+            if (inFlight == 0) break;
+            finished.wait(lock, [this] { return !done.empty(); });
+        }
+    }
+    // Handler thread: replies after any reads that have already finished
+    void send(const std::string& msg) {
+        std::unique_lock<std::mutex> lock(mutex);
+        flush(lock);
+        lock.unlock();
+        sendAll(msg);
+    }
+    // Handler thread: recv() that delivers finished replies while it blocks
+    ssize_t receive(char* buf, size_t len) {
+        pollfd fds[2] = {{fd, POLLIN, 0}, {wakeFd, POLLIN, 0}};
+        while (true) {
+            if (poll(fds, 2, -1) < 0) {
+                if (errno == EINTR) continue;
+                return -1;
+            }
+            if (fds[1].revents & POLLIN) {
+                eventfd_t count;
+                eventfd_read(wakeFd, &count);
+                std::unique_lock<std::mutex> lock(mutex);
+                flush(lock);
+            }
+            if (fds[0].revents) return recv(fd, buf, len, 0);
+        }
     }
-    H.resize(k - 1);
-    return H;
-}
 
-float polygonArea(const std::vector<Point>& poly) {
-    float area = 0.0f;
-    int n = poly.size();
-    for (int i = 0; i < n; ++i) {
-        const Point& p1 = poly[i];
-        const Point& p2 = poly[(i + 1) % n];
-        area += (p1.x * p2.y) - (p2.x * p1.y);
+private:
+    // Sends the queued replies without holding the lock
+    void flush(std::unique_lock<std::mutex>& lock) {
+        while (!done.empty()) {
+            std::deque<std::string> batch;
+            batch.swap(done);
+            lock.unlock();
+            for (const std::string& msg : batch) sendAll(msg);
+            lock.lock();
+        }
+    }
+    // Loops over short writes; MSG_NOSIGNAL turns a vanished peer into an error
+    void sendAll(const std::string& msg) {
+        size_t sent = 0;
+        while (!broken && sent < msg.size()) {
+            ssize_t n = ::send(fd, msg.data() + sent, msg.size() - sent, MSG_NOSIGNAL);
+            if (n > 0) sent += n;
+            else if (n < 0 && errno == EINTR) continue;
+            else broken = true;
+        }
     }
-    return std::abs(area) / 2.0f;
+};
+
+bool is_query(const std::string& cmd) {
+    return cmd == "CH" || cmd == "Inside" || cmd == "Extreme" || cmd == "Diameter";
 }
 
-std::string trim(const std::string& s) {
-    size_t start = s.find_first_not_of(" \t\r\n");
-    size_t end = s.find_last_not_of(" \t\r\n");
-    return (start == std::string::npos) ? "" : s.substr(start, end - start + 1);
+// Read-only commands, answered from the graph's published snapshot without
+// locking. Arguments that do not parse get the same reply as an unknown
+// command, tagged or not.
+std::string answer_query(const Graph& graph, const std::string& cmd, const char* args, const char* end) {
+    EpochGuard guard(graphs.epochs());
+    const GraphSnapshot* snap = graph.current();
+    std::ostringstream oss;
+    if (cmd == "CH") {
+        float area = snap->area;
+        oss << std::fixed << std::setprecision(6) << area << "\n";
+    } else if (cmd == "Inside") {
+        Point p;
+        if (parsePoint(args, end, p)) oss << (snap->queries.inside(p) ? "Inside\n" : "Outside\n");
+    } else if (cmd == "Extreme") {
+        Point d;
+        if (parsePoint(args, end, d) && (d.x != 0 || d.y != 0)) {
+            if (snap->queries.empty()) {
+                oss << "Empty graph.\n";
+            } else {
+                Point e = snap->queries.extreme(d.x, d.y);
+                oss << e.x << "," << e.y << "\n";
+            }
+        }
+    } else if (cmd == "Diameter") {
+        oss << std::fixed << std::setprecision(6) << snap->queries.diameter() << " "
+            << snap->queries.width() << "\n";
+    }
+    std::string out = oss.str();
+    return out.empty() ? "Invalid command.\n" : out;
 }
 
 // Client handler function
 void* handle_client(int client_fd) {
     char buffer[BUFFER_SIZE];
     std::string input_buffer;
+    Graph* graph = default_graph;
+    long long graph_input_remaining = 0; // Points still expected after Newgraph
+    bool dirty = false;                  // Graph changed since this client last published
+    long long binary_points_pending = 0; // Raw points still to read for "Addpoints binary n"
+    std::string binary_tag;              // Tag of that upload
+    bool binary_mode = false;            // Framed WireProtocol after "Binary"
+    bool hangup = false;
+    Pipeline pipeline(client_fd);
+    std::string tag;                     // "#id " of the line being handled, empty if untagged
+    bool replied = false;
 
-    send(client_fd, "Welcome to the convex hull server!\n", 35, 0);
+    auto reply = [&pipeline, &tag, &replied](const std::string& out) {
+        pipeline.send(tag + out);
+        replied = true;
+    };
+
+    // Makes this client's own changes visible before it reads them back
+    // or switches to another graph
+    auto publish_own = [&graph, &dirty]() {
+        if (dirty) {
+            graph->publish();
+            dirty = false;
+        }
+    };
+
+    // Graph mutations, shared by the text and binary protocols
+    // False, keeping the current graph, when the registry is full
+    auto use_graph = [&](const std::string& name) {
+        Graph* next = graphs.get(name);
+        if (!next) return false;
+        publish_own();
+        graph = next;
+        graph_input_remaining = 0;
+        return true;
+    };
+    auto restart_graph = [&graph, &dirty]() {
+        std::lock_guard<std::mutex> g_lock(graph->mutex);
+        graph->hull.clear();
+        ++graph->version;
+        dirty = true;
+    };
+    auto insert_point = [&graph, &dirty](const Point& p) {
+        std::lock_guard<std::mutex> g_lock(graph->mutex);
+        graph->hull.insert(p);
+        ++graph->version;
+        dirty = true;
+    };
+    auto remove_point = [&graph, &dirty](const Point& p) {
+        std::lock_guard<std::mutex> g_lock(graph->mutex);
+        if (!graph->hull.erase(p)) return false;
+        ++graph->version;
+        dirty = true;
+        return true;
+    };
+
+    // Appends a whole upload under one lock acquisition; with replace, the
+    // graph is emptied first under the same hold, so no other writer lands between
+    auto add_points = [&graph, &dirty](const std::vector<Point>& batch, bool replace = false) {
+        std::lock_guard<std::mutex> g_lock(graph->mutex);
+        if (replace) graph->hull.clear();
+        graph->hull.insert(batch);
+        ++graph->version;
+        dirty = true;
+    };
+    auto add_points_and_ack = [&add_points, &reply](const std::vector<Point>& batch) {
+        add_points(batch);
+        reply("Added " + std::to_string(batch.size()) + " point(s).\n");
+    };
+
+    // One binary request, answered with exactly one frame
+    auto answer_frame = [&](uint16_t op, const char* payload, size_t len) -> std::string {
+        // Only the point-taking ops decode the payload: a graph name may be 8 bytes too
+        Point p = {0, 0};
+        bool onePoint = len == 8;
+        auto decode_point = [&]() {
+            decodePoints(payload, 1, &p);
+            return isFinite(p);
+        };
+        const char* invalidPoint = "Invalid point.";
+
+        switch (op) {
+        case WIRE_USE:
+            if (len == 0) break;
+            if (!use_graph(std::string(payload, len))) {
+                return WireFrame(WIRE_ERROR).text("Too many graphs.").data();
+            }
+            return WireFrame(op).data();
+        case WIRE_NEWGRAPH:
+        case WIRE_ADDPOINTS: {
+            if (len % 8 != 0) break;
+            std::vector<Point> batch(len / 8);
+            decodePoints(payload, batch.size(), batch.data());
+            if (!allFinite(batch)) return WireFrame(WIRE_ERROR).text("Invalid points.").data();
+            add_points(batch, op == WIRE_NEWGRAPH);
+            return WireFrame(op).u64(batch.size()).data();
+        }
+        case WIRE_NEWPOINT:
+            if (!onePoint) break;
+            if (!decode_point()) return WireFrame(WIRE_ERROR).text(invalidPoint).data();
+            insert_point(p);
+            return WireFrame(op).data();
+        case WIRE_REMOVEPOINT:
+            if (!onePoint) break;
+            if (!decode_point()) return WireFrame(WIRE_ERROR).text(invalidPoint).data();
+            return WireFrame(op).u8(remove_point(p)).data();
+        case WIRE_CH:
+        case WIRE_HULL:
+        case WIRE_DIAMETER:
+        case WIRE_INSIDE:
+        case WIRE_EXTREME: {
+            bool takesPoint = op == WIRE_INSIDE || op == WIRE_EXTREME;
+            if (takesPoint ? !onePoint : len != 0) break;
+            if (takesPoint && !decode_point()) return WireFrame(WIRE_ERROR).text(invalidPoint).data();
+            if (op == WIRE_EXTREME && p.x == 0 && p.y == 0) break;
+            publish_own();
+            EpochGuard guard(graphs.epochs());
+            const GraphSnapshot* snap = graph->current();
+            WireFrame frame(op);
+            if (op == WIRE_CH) {
+                frame.f32(snap->area);
+            } else if (op == WIRE_HULL) {
+                frame.points(snap->queries.vertices());
+            } else if (op == WIRE_DIAMETER) {
+                frame.f64(snap->queries.diameter()).f64(snap->queries.width());
+            } else if (op == WIRE_INSIDE) {
+                frame.u8(snap->queries.inside(p));
+            } else if (!snap->queries.empty()) {
+                frame.point(snap->queries.extreme(p.x, p.y));
+            }
+            return frame.data();
+        }
+        }
+        return WireFrame(WIRE_ERROR).text("Invalid request.").data();
+    };
+
+    reply("Welcome to the convex hull server!\n");
 
     while (true) {
-        ssize_t bytes = recv(client_fd, buffer, BUFFER_SIZE - 1, 0);
+        ssize_t bytes = hangup ? 0 : pipeline.receive(buffer, BUFFER_SIZE);
         if (bytes <= 0) {
+            pipeline.wait();
             close(client_fd);
-            std::lock_guard<std::mutex> lock(client_state_mutex);
-            client_graph_input_remaining.erase(client_fd);
+            publish_own();
             return nullptr;
         }
 
-        buffer[bytes] = '\0';
-        input_buffer += buffer;
+        input_buffer.append(buffer, bytes);
+
+        // Consumed input is erased once per recv, not once per line
+        size_t start = 0;
+        while (!hangup) {
+            if (binary_mode) {
+                WireHeader h;
+                if (!readWireHeader(input_buffer.data() + start, input_buffer.size() - start, h)) break;
+                if (h.length > kMaxWirePayload) {
+                    // The stream cannot be resynchronized past a bad length
+                    pipeline.send(WireFrame(WIRE_ERROR).text("Frame too large.").data());
+                    hangup = true;
+                    break;
+                }
+                if (input_buffer.size() - start < kWireHeaderSize + h.length) break;
+                const char* payload = input_buffer.data() + start + kWireHeaderSize;
+                pipeline.send(answer_frame(h.opcode, payload, h.length));
+                start += kWireHeaderSize + h.length;
+                continue;
+            }
+
+            if (binary_points_pending > 0) {
+                size_t need = binary_points_pending * 8;
+                if (input_buffer.size() - start < need) break;
+                std::vector<Point> batch(binary_points_pending);
+                decodePoints(input_buffer.data() + start, batch.size(), batch.data());
+                start += need;
+                binary_points_pending = 0;
+                pipeline.wait();
+                tag = binary_tag;
+                // Raw floats can carry NaN or infinity bit patterns
+                if (allFinite(batch)) add_points_and_ack(batch);
+                else reply("Invalid points.\n");
+                continue;
+            }
 
-        size_t pos;
-        while ((pos = input_buffer.find('\n')) != std::string::npos) {
-            std::string line = trim(input_buffer.substr(0, pos));
-            input_buffer.erase(0, pos + 1);
+            size_t pos = input_buffer.find('\n', start);
+            if (pos == std::string::npos) break;
+            std::string line = trim(input_buffer.substr(start, pos - start));
+            start = pos + 1;
 
             if (line.empty()) continue;
 
-            std::istringstream iss(line);
-            std::string cmd;
-            iss >> cmd;
+            tag.clear();
+            replied = false;
+            if (line[0] == '#') {
+                size_t tagLen = std::min(line.find_first_of(" \t"), line.size());
+                tag = line.substr(0, tagLen) + " ";
+                line = trim(line.substr(tagLen));
+            }
 
-            if (cmd == "Newgraph") {
-                int n;
-                if (iss >> n) {
-                    {
-                        std::lock_guard<std::mutex> g_lock(graph_mutex);
-                        global_graph.clear();
-                    }
-                    {
-                        std::lock_guard<std::mutex> lock(client_state_mutex);
-                        client_graph_input_remaining[client_fd] = n;
-                    }
+            const char* end = line.data() + line.size();
+            size_t cmdLen = std::min(line.find_first_of(" \t"), line.size());
+            std::string cmd = line.substr(0, cmdLen);
+            const char* args = line.data() + cmdLen;
+
+            // Tagged reads go to the pool; every other command waits for them
+            if (is_query(cmd) && !tag.empty()) {
+                publish_own();
+                pipeline.begin();
+                query_pool.submit([&pipeline, g = graph, t = tag, line, cmdLen]() {
+                    pipeline.finish(t + answer_query(*g, line.substr(0, cmdLen), line.data() + cmdLen,
+                                                     line.data() + line.size()));
+                });
+                continue;
+            }
+            pipeline.wait();
+
+            if (is_query(cmd)) {
+                publish_own();
+                reply(answer_query(*graph, cmd, args, end));
+            } else if (cmd == "Newgraph") {
+                // "Newgraph n" restarts the current graph, "Newgraph <name> n" switches first
+                std::string name;
+                long long n;
+                const char* rest = parseWord(args, end, name);
+                bool named = rest && parseCount(rest, end, n);
+                if (named && !use_graph(name)) {
+                    reply("Too many graphs.\n");
+                } else if (named || parseCount(args, end, n)) {
+                    restart_graph();
+                    graph_input_remaining = n;
                     std::ostringstream msg;
                     msg << "Expecting " << n << " point(s)...\n";
-                    send(client_fd, msg.str().c_str(), msg.str().size(), 0);
+                    reply(msg.str());
                 }
-            } else if (cmd == "Newpoint") {
-                float x, y;
-                if (iss >> x >> y) {
-                    std::lock_guard<std::mutex> g_lock(graph_mutex);
-                    global_graph.push_back({x, y});
+            } else if (cmd == "Use") {
+                std::string name;
+                if (parseWord(args, end, name)) {
+                    if (use_graph(name)) reply("Using graph " + name + ".\n");
+                    else reply("Too many graphs.\n");
                 }
-            } else if (cmd == "Removepoint") {
-                float x, y;
-                if (iss >> x >> y) {
-                    Point target = {x, y};
-                    std::lock_guard<std::mutex> g_lock(graph_mutex);
-                    auto it = std::find(global_graph.begin(), global_graph.end(), target);
-                    if (it != global_graph.end()) {
-                        global_graph.erase(it);
+            } else if (cmd == "Addpoints") {
+                // "Addpoints x,y x,y ..." or "Addpoints binary n" followed by n raw
+                // little-endian float pairs
+                std::string word;
+                const char* rest = parseWord(args, end, word);
+                long long n;
+                if (rest && word == "binary") {
+                    if (parseCount(rest, end, n) && n >= 0 && n <= kMaxBinaryPoints) {
+                        if (n == 0) add_points_and_ack({});
+                        binary_points_pending = n;
+                        binary_tag = tag;
+                    } else {
+                        reply("Invalid points.\n");
                     }
+                } else {
+                    std::vector<Point> batch;
+                    const char* cur = args;
+                    Point p;
+                    while (cur && cur < end) {
+                        cur = parsePoint(cur, end, p);
+                        if (cur) batch.push_back(p);
+                    }
+                    if (cur) add_points_and_ack(batch);
+                    else reply("Invalid points.\n");
                 }
-            } else if (cmd == "CH") {
-                std::vector<Point> local_copy;
-                {
-                    std::lock_guard<std::mutex> g_lock(graph_mutex);
-                    local_copy = global_graph;
-                }
-                std::vector<Point> hull = convexHull(local_copy);
-                float area = polygonArea(hull);
-                std::ostringstream oss;
-                oss << std::fixed << std::setprecision(6) << area << "\n";
-                std::string out = oss.str();
-                send(client_fd, out.c_str(), out.size(), 0);
+            } else if (cmd == "Newpoint") {
+                Point p;
+                if (parsePoint(args, end, p)) insert_point(p);
+            } else if (cmd == "Removepoint") {
+                Point p;
+                if (parsePoint(args, end, p)) remove_point(p);
+            } else if (cmd == "Binary") {
+                reply("Binary mode.\n");
+                binary_mode = true;
             } else {
                 // Try parse as point input if in Newgraph state
-                float x, y;
-                std::replace(line.begin(), line.end(), ',', ' ');
-                std::istringstream ps(line);
-                if (ps >> x >> y) {
-                    bool accepted = false;
-                    {
-                        std::lock_guard<std::mutex> lock(client_state_mutex);
-                        if (client_graph_input_remaining[client_fd] > 0) {
-                            std::lock_guard<std::mutex> g_lock(graph_mutex);
-                            global_graph.push_back({x, y});
-                            client_graph_input_remaining[client_fd]--;
-                            accepted = true;
-                        }
-                    }
-                    if (accepted) {
+                Point p;
+                if (parsePoint(line.data(), end, p)) {
+                    if (graph_input_remaining > 0) {
+                        insert_point(p);
+                        graph_input_remaining--;
                         std::ostringstream oss;
-                        oss << "Added point: (" << x << "," << y << ")\n";
-                        send(client_fd, oss.str().c_str(), oss.str().size(), 0);
+                        oss << "Added point: (" << p.x << "," << p.y << ")\n";
+                        reply(oss.str());
                     } else {
-                        send(client_fd, "Unexpected point. Use Newgraph first.\n", 38, 0);
+                        reply("Unexpected point. Use Newgraph first.\n");
                     }
                 } else {
-                    send(client_fd, "Invalid command.\n", 18, 0);
+                    reply("Invalid command.\n");
                 }
             }
+            if (!tag.empty() && !replied && binary_points_pending == 0) reply("OK\n");
         }
+        input_buffer.erase(0, start);
+
+        // One publish per batch of lines received, not per mutation
+        publish_own();
     }
 
     return nullptr;